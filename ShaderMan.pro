@@ -4,7 +4,7 @@
 #
 #-------------------------------------------------
 
-QT       += core gui widgets opengl
+QT       += core gui widgets opengl concurrent
 
 #greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -29,6 +29,7 @@ include(profiling/profile.pri)
 include(texture/texture.pri)
 include(uniform/uniform.pri)
 include(project_settings/projectSettings.pri)
+include(render/render.pri)
 
 SOURCES += main.cpp\
     mainwindow.cpp \
@@ -57,7 +58,10 @@ SOURCES += main.cpp\
     storage/gltexture.cpp \
     tools/datatimer.cpp \
     storage/projectmanagertreemodel.cpp \
-    storage/projecttreeitem.cpp
+    storage/projecttreeitem.cpp \
+    storage/uniformblock.cpp \
+    storage/programbinarycache.cpp \
+    storage/textureuploader.cpp
 
 HEADERS  += mainwindow.h \
     codeeditor.h \
@@ -86,7 +90,10 @@ HEADERS  += mainwindow.h \
     storage/gltexture.h \
     tools/datatimer.h \
     storage/projectmanagertreemodel.h \
-    storage/projecttreeitem.h
+    storage/projecttreeitem.h \
+    storage/uniformblock.h \
+    storage/programbinarycache.h \
+    storage/textureuploader.h
 
 FORMS    += mainwindow.ui \
     dialogs/newfile/newfiledialog.ui \
@@ -68,7 +68,7 @@ public slots:
 protected:
     const static quint32 magicNumber = 0xC56EE8F8;
     const static qint32 versionMajorNumber = 0;
-    const static qint32 versionMinorNumber = 1;
+    const static qint32 versionMinorNumber = 4;
 
 private:
     QHash<QString,MetaProject*> projects;
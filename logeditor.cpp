@@ -19,7 +19,9 @@ LogEditor::LogEditor(QTextEdit *logWindow)
 void LogEditor::setLogWindow(QTextEdit* log)
 {
     window = log;
-    window->document()->setMaximumBlockCount(maxLines);
+
+    if(window != NULL)
+        window->document()->setMaximumBlockCount(maxLines);
 }
 
 /**
@@ -27,6 +29,9 @@ void LogEditor::setLogWindow(QTextEdit* log)
   */
 void LogEditor::newCompiling()
 {
+    if(window == NULL)
+        return;
+
     QString str = window->toPlainText();
     window->setTextColor(QColor(Qt::gray));
     window->setText(str);
@@ -38,6 +43,12 @@ void LogEditor::newCompiling()
   */
 void LogEditor::addVertexLog(QString log)
 {
+    if(window == NULL)
+    {
+        qWarning() << "VERTEX SHADER" << qPrintable(log);
+        return;
+    }
+
     window->setTextColor(QColor(Qt::blue));
     window->append("VERTEX SHADER");
     window->setTextColor(QColor(Qt::black));
@@ -50,6 +61,12 @@ void LogEditor::addVertexLog(QString log)
   */
 void LogEditor::addFragmentLog(QString log)
 {
+    if(window == NULL)
+    {
+        qWarning() << "FRAGMENT SHADER" << qPrintable(log);
+        return;
+    }
+
     window->setTextColor(QColor(Qt::blue));
     window->append("FRAGMENT SHADER");
     window->setTextColor(QColor(Qt::black));
@@ -62,6 +79,12 @@ void LogEditor::addFragmentLog(QString log)
   */
 void LogEditor::addLinkLog(QString log)
 {
+    if(window == NULL)
+    {
+        qWarning() << "LINKING SHADER" << qPrintable(log);
+        return;
+    }
+
     window->setTextColor(QColor(Qt::blue));
     window->append("LINKING SHADER");
     window->setTextColor(QColor(Qt::black));
@@ -75,6 +98,12 @@ void LogEditor::addLinkLog(QString log)
  */
 void LogEditor::addFileError(QString log)
 {
+    if(window == NULL)
+    {
+        qWarning() << qPrintable(log);
+        return;
+    }
+
     window->setTextColor(QColor(Qt::black));
     window->append(log);
     window->moveCursor(QTextCursor::End);
@@ -86,6 +115,12 @@ void LogEditor::addFileError(QString log)
  */
 void LogEditor::addUniformError(QString log)
 {
+    if(window == NULL)
+    {
+        qWarning() << "UNIFORM VARIABLE ERROR" << qPrintable(log);
+        return;
+    }
+
     window->setTextColor(QColor(Qt::black));
     window->append("UNIFORM VARIABLE ERROR");
     window->append(log);
@@ -98,6 +133,12 @@ void LogEditor::addUniformError(QString log)
  */
 void LogEditor::addBufferError(QString log)
 {
+    if(window == NULL)
+    {
+        qWarning() << "OPENGL BUFFER ERROR" << qPrintable(log);
+        return;
+    }
+
     window->setTextColor(QColor(Qt::black));
     window->append("OPENGL BUFFER ERROR");
     window->append(log);
@@ -109,6 +150,12 @@ void LogEditor::addBufferError(QString log)
   */
 void LogEditor::addToLog(QString str)
 {
+    if(window == NULL)
+    {
+        qWarning() << qPrintable(str);
+        return;
+    }
+
     window->setPlainText(window->toPlainText() + str);
 }
 
@@ -118,5 +165,11 @@ void LogEditor::addToLog(QString str)
  */
 void LogEditor::addToCompiling(QString str)
 {
+    if(window == NULL)
+    {
+        qWarning() << qPrintable(str);
+        return;
+    }
+
     window->setPlainText(window->toPlainText() + str);
 }
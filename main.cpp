@@ -1,13 +1,70 @@
 #include <QApplication>
+#include <QDebug>
 #include "mainwindow.h"
+#include "infomanager.h"
+#include "render/offscreenrenderer.h"
 #include <cmath>
 
+// size of images rendered from command line
+#define OFFSCREEN_WIDTH 1280
+#define OFFSCREEN_HEIGHT 720
+
+/**
+ * @brief renderOffscreen Load project, render one frame of it without window and save it to image file.
+ * @param projectPath Path to project file (.sm).
+ * @param imagePath Path to output image, format is given by suffix.
+ * @return Exit code of application, 0 on success.
+ */
+static int renderOffscreen(const QString &projectPath, const QString &imagePath)
+{
+    OffscreenRenderer renderer;
+
+    if(!renderer.create(QSize(OFFSCREEN_WIDTH, OFFSCREEN_HEIGHT)))
+        return 1;
+
+    if(!InfoManager::getInstance()->loadProject(projectPath))
+    {
+        qWarning() << "Project" << projectPath << "canno't be loaded";
+        return 1;
+    }
+
+    // the same as activation of project in main window
+    RenderCore* core = renderer.getRenderCore();
+    core->setOpenGLSettings();
+    core->runShaders();
+
+    QImage image = renderer.renderFrame();
+
+    if(image.isNull() || !image.save(imagePath))
+    {
+        qWarning() << "Image" << imagePath << "canno't be rendered";
+        return 1;
+    }
+
+    return 0;
+}
+
 int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
 
+    // headless rendering: ShaderMan --render-offscreen <project> <out.png>
+    QStringList arguments = a.arguments();
+    int offscreen = arguments.indexOf("--render-offscreen");
+
+    if(offscreen != -1)
+    {
+        if(arguments.size() < offscreen + 3)
+        {
+            qWarning() << "Usage:" << arguments.first() << "--render-offscreen <project> <image>";
+            return 1;
+        }
+
+        return renderOffscreen(arguments.at(offscreen + 1), arguments.at(offscreen + 2));
+    }
+
     MainWindow w;
     w.show();
-    
+
     return a.exec();
 }
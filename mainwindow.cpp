@@ -2,6 +2,8 @@
 #include "ui_mainwindow.h"
 #include "storage/projecttreeitem.h"
 #include "project_settings/dialog/openglsettingsdialog.h"
+#include "model_work/tools/meshsimplifier.h"
+#include <QActionGroup>
 
 /**
  * @brief MainWindow::MainWindow Create main window of application
@@ -25,6 +27,7 @@ MainWindow::MainWindow(QWidget *parent) :
 
     ui->dockWidgetContents->setGLWindow(ui->GL_Window_underlay->returnOGLwindow());
 
+    initLodMenu();
     connectSignals();
 }
 
@@ -71,6 +74,33 @@ void MainWindow::closeEvent(QCloseEvent *event)
     }
 }
 
+/**
+ * @brief MainWindow::initLodMenu Create menu for selection of level of detail used for all meshes in viewport.
+ */
+void MainWindow::initLodMenu()
+{
+    QMenu* menu = ui->menu_View->addMenu(tr("&Level of Detail"));
+    QActionGroup* group = new QActionGroup(this);
+
+    QAction* automatic = menu->addAction(tr("&Automatic"));
+    automatic->setData(-1);
+    automatic->setCheckable(true);
+    automatic->setChecked(true);
+    group->addAction(automatic);
+
+    menu->addSeparator();
+
+    for(int level = 0; level <= MeshSimplifier::maxLodLevels; ++level)
+    {
+        QAction* action = menu->addAction(tr("LOD %1").arg(level));
+        action->setData(level);
+        action->setCheckable(true);
+        group->addAction(action);
+    }
+
+    connect(group,SIGNAL(triggered(QAction*)),this,SLOT(setLodOverride(QAction*)));
+}
+
 /**
   Connect custom slots and signals
   */
@@ -121,6 +151,15 @@ void MainWindow::connectSignals()
 
     connect(this,SIGNAL(pauseDrawing(bool)),ui->GL_Window_underlay->returnOGLwindow(),SLOT(pauseDrawing(bool)));
 
+    // frame scheduling
+    connect(ui->action_Continuous_rendering,SIGNAL(toggled(bool)),
+            ui->GL_Window_underlay->returnOGLwindow(),SLOT(setContinuousRendering(bool)));
+    connect(ui->action_Vertical_sync,SIGNAL(toggled(bool)),
+            ui->GL_Window_underlay->returnOGLwindow(),SLOT(setVSync(bool)));
+    connect(ui->action_Occlusion_culling,SIGNAL(toggled(bool)),
+            ui->GL_Window_underlay->returnOGLwindow(),SLOT(setOcclusionCulling(bool)));
+    connect(ui->GL_Window_underlay->returnOGLwindow(),SIGNAL(fpsMeasured(double)),this,SLOT(showFps(double)));
+
     connect(infoM,SIGNAL(projectCreated(QString)),this,SLOT(connectCreatedProject(QString)));
     connect(infoM,SIGNAL(projectRemoved(QString)),this,SLOT(projectRemoved(QString)));
     connect(infoM,SIGNAL(defaultProjectChanged(QString,QString)),this,SLOT(buildShader()));
@@ -498,6 +537,7 @@ void MainWindow::showLoadModelDialog()
         return;
 
     Model* model = new Model(0,infoM->getActiveProject()->getName());
+    model->setLodGeneration(infoM->getActiveProject()->getSettings()->isLodGeneration());
 
     if(model->loadModel(modelFile))
     {
@@ -680,6 +720,25 @@ void MainWindow::showMeasureDockWidget()
     ui->dockWidget->setVisible(true);
 }
 
+/**
+ * @brief MainWindow::showFps Show achieved frames per second of OpenGL window in status bar.
+ * @param fps Frames per second.
+ */
+void MainWindow::showFps(double fps)
+{
+    QString mode = ui->action_Continuous_rendering->isChecked() ? tr("continuous") : tr("idle");
+    ui->statusBar->showMessage(tr("%1 FPS (%2)").arg(fps, 0, 'f', 1).arg(mode));
+}
+
+/**
+ * @brief MainWindow::setLodOverride Set level of detail selected in menu to viewport.
+ * @param action Selected action, its data contain level of detail or -1 for automatic selection.
+ */
+void MainWindow::setLodOverride(QAction *action)
+{
+    ui->GL_Window_underlay->returnOGLwindow()->setLodOverride(action->data().toInt());
+}
+
 /**
  * @brief MainWindow::buildShader Test if active project is set, if is then build and run new shaders.
  */
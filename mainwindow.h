@@ -37,6 +37,7 @@ protected:
 
 private:
     void connectSignals();
+    void initLodMenu();
     bool isProjectActive(const QString proj = "", bool printWarnings = true);
     
 private slots:
@@ -61,6 +62,8 @@ private slots:
     void showTextureDialog();
 
     void showMeasureDockWidget();
+    void showFps(double fps);
+    void setLodOverride(QAction* action);
 
     void buildShader();
     void removeShader();
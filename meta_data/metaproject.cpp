@@ -149,6 +149,12 @@ void MetaProject::saveProject(QDataStream &out)
 
     out << settings;
 
+    // replication of the model is stored since version 0.2
+    qint32 replication = settings->getReplicationColumns();
+    out << replication;
+    replication = settings->getReplicationRows();
+    out << replication;
+
     out << vertexM;
     out << fragmentM;
 
@@ -167,6 +173,19 @@ void MetaProject::saveProject(QDataStream &out)
 
     out << textures;
 
+    // compression of textures is stored since version 0.3
+    QHash<QString,qint32> compression;
+
+    foreach(TextureStorage* tex, textures.values())
+    {
+        compression.insert(tex->getName(), tex->getCompression());
+    }
+
+    out << compression;
+
+    // generation of levels of detail is stored since version 0.4
+    out << settings->isLodGeneration();
+
     bool loaded = isModelLoaded();
     out << loaded;
 
@@ -182,7 +201,7 @@ void MetaProject::saveProject(QDataStream &out)
 /**
   Load MetaProject data to QDataStream
   */
-void MetaProject::loadProject(QDataStream &in, QString basePath, int /*versionMajor*/, int /*versionMinor*/)
+void MetaProject::loadProject(QDataStream &in, QString basePath, int versionMajor, int versionMinor)
 {
     //basePath = QDir::toNativeSeparators(basePath);
 
@@ -202,6 +221,14 @@ void MetaProject::loadProject(QDataStream &in, QString basePath, int /*versionMa
     in >> settings;
     settings->setParent(this);
 
+    if(versionMajor > 0 || versionMinor >= 2)
+    {
+        qint32 columns, rows;
+        in >> columns;
+        in >> rows;
+        settings->setReplication(columns, rows);
+    }
+
     in >> vertexM;
     in >> fragmentM;
 
@@ -261,6 +288,24 @@ void MetaProject::loadProject(QDataStream &in, QString basePath, int /*versionMa
             connect(s, SIGNAL(nameChanged(QString)),this,SLOT(texNameChanged()));
     }
 
+    if(versionMajor > 0 || versionMinor >= 3)
+    {
+        QHash<QString,qint32> compression;
+        in >> compression;
+
+        foreach(TextureStorage* s, textures)
+        {
+            s->setCompression(static_cast<TextureStorage::TexCompression>(compression.value(s->getName(), 0)));
+        }
+    }
+
+    if(versionMajor > 0 || versionMinor >= 4)
+    {
+        bool lodGeneration;
+        in >> lodGeneration;
+        settings->setLodGeneration(lodGeneration);
+    }
+
     bool loaded;
     in >> loaded;
 
@@ -285,6 +330,7 @@ void MetaProject::loadProject(QDataStream &in, QString basePath, int /*versionMa
         }
         else
         {
+            activeModel->setLodGeneration(settings->isLodGeneration());
             activeModel->loadModel();
             QHash<QPair<uint,uint>,QString> attachProgs;
             in >> attachProgs;
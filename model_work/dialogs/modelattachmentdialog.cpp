@@ -216,6 +216,14 @@ QPair<QList<QStandardItem *>, QList<QStandardItem *> > ModelAttachmentDialog::ad
     {
         type.append(new QStandardItem(indices));
         count.append(new QStandardItem(QString("%1").arg(mesh->getNumberIndices())));
+
+        type.append(new QStandardItem(tr("Index size")));
+        count.append(new QStandardItem(mesh->hasShortIndices() ? tr("16 bit") : tr("32 bit")));
+
+        // vertex transformations per triangle before and after optimization of triangle order
+        type.append(new QStandardItem(tr("ACMR")));
+        count.append(new QStandardItem(QString("%1 / %2").arg(mesh->getAcmrBefore(), 0, 'f', 3)
+                                       .arg(mesh->getAcmrAfter(), 0, 'f', 3)));
     }
 
     return qMakePair(type,count);
@@ -13,6 +13,7 @@ ModelValuesViewer::ModelValuesViewer(Mesh *mesh, QString name, QWidget *parent)
     ui->label->setText(name);
 
     initTable();
+    initLodInfo();
 }
 
 ModelValuesViewer::~ModelValuesViewer()
@@ -20,6 +21,21 @@ ModelValuesViewer::~ModelValuesViewer()
     delete ui;
 }
 
+/**
+ * @brief ModelValuesViewer::initLodInfo Show number of triangles of every level of detail of mesh.
+ */
+void ModelValuesViewer::initLodInfo()
+{
+    QStringList levels;
+
+    for(int lod = 0; lod < mesh->getLodCount(); ++lod)
+    {
+        levels << tr("LOD %1: %2 triangles").arg(lod).arg(mesh->getNumberIndices(lod) / 3);
+    }
+
+    ui->lodLabel->setText(levels.join(", "));
+}
+
 /**
  * @brief ModelValuesViewer::initTable Initialize QTableView model
  */
@@ -19,6 +19,7 @@ public:
 
 private:
     void initTable();
+    void initLodInfo();
     
 private:
     Ui::ModelValuesViewer *ui;
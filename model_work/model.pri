@@ -7,7 +7,9 @@ HEADERS +=  model_work/dialogs/modelattachmentdialog.h \
     model_work/dialogs/modelvaluesviewer.h \
     model_work/dialogs/pickshprogdialog.h \
     model_work/tools/assimpprogresshandler.h \
-    model_work/tools/nodeshprogstruct.h
+    model_work/tools/nodeshprogstruct.h \
+    model_work/tools/meshsimplifier.h \
+    model_work/tools/vertexcacheoptimizer.h
 
 SOURCES +=  model_work/dialogs/modelattachmentdialog.cpp \
     model_work/storage/modelnode.cpp \
@@ -16,7 +18,9 @@ SOURCES +=  model_work/dialogs/modelattachmentdialog.cpp \
     model_work/dialogs/modelvaluesviewer.cpp \
     model_work/dialogs/pickshprogdialog.cpp \
     model_work/tools/assimpprogresshandler.cpp \
-    model_work/tools/nodeshprogstruct.cpp
+    model_work/tools/nodeshprogstruct.cpp \
+    model_work/tools/meshsimplifier.cpp \
+    model_work/tools/vertexcacheoptimizer.cpp
 
 FORMS +=    model_work/dialogs/modelattachmentdialog.ui \
     model_work/dialogs/modelvaluesviewer.ui \
@@ -1,5 +1,7 @@
 #include "mesh.h"
 #include <QtAlgorithms>
+#include <qmath.h>
+#include <algorithm>
 
 //static member of class
 unsigned long Mesh::counter = 0;
@@ -33,13 +35,17 @@ Mesh::Mesh(unsigned int numVertex, float *vertices,
     this->colors = colors;
     this->texCoords = texCoords;
     this->indices = indices;
-    this->vBuffer = 0;
-    this->nBuffer = 0;
-    this->iBuffer = 0;
+    this->vOffset = 0;
+    this->nOffset = 0;
+    this->iOffset = 0;
+    this->acmrBefore = 0.f;
+    this->acmrAfter = 0.f;
 
     index = counter;
     counter++;
 
+    computeBounds();
+
     qDebug() << "Created mesh with index: " << index;
 }
 
@@ -117,11 +123,18 @@ float *Mesh::getTexCoords(int id)
 
 /**
  * @brief Mesh::getIndices Return values of indices for this mesh
- * @return Indices in this mesh as array of unsigned ints
+ * @param lod Level of detail, 0 for original indices.
+ * @return Indices in this mesh as array of unsigned ints, NULL if level does not exist
  */
-unsigned int *Mesh::getIndices()
+unsigned int *Mesh::getIndices(int lod)
 {
-    return indices;
+    if(lod <= 0)
+        return indices;
+
+    if(lod > lodIndices.size())
+        return NULL;
+
+    return lodIndices[lod - 1].data();
 }
 
 /* Get counts methods */
@@ -172,11 +185,15 @@ unsigned int Mesh::getNumberNormals()
 
 /**
  * @brief Mesh::getNumberIndices Return number of indices (unsigned ints) in this mesh
+ * @param lod Level of detail, 0 for original indices.
  * @return Number of indices (unsigned ints in array)
  */
-unsigned int Mesh::getNumberIndices()
+unsigned int Mesh::getNumberIndices(int lod)
 {
-    return numIndices;
+    if(lod <= 0)
+        return numIndices;
+
+    return lodIndices.value(lod - 1).size();
 }
 
 /* Get size methods */
@@ -226,116 +243,304 @@ size_t Mesh::getSizeNormals()
 }
 
 /**
- * @brief Mesh::getSizeIndices Return size of indices array as bytes
+ * @brief Mesh::getSizeIndices Return size of indices in element buffer as bytes, see getIndexSize
+ * @param lod Level of detail, 0 for original indices.
  * @return Size in bytes
  */
-size_t Mesh::getSizeIndices()
+size_t Mesh::getSizeIndices(int lod)
+{
+    return getNumberIndices(lod) * getIndexSize();
+}
+
+/**
+ * @brief Mesh::getCenter Return center of box around all vertices of this mesh
+ * @return Center in mesh coordinates
+ */
+QVector3D Mesh::getCenter()
+{
+    return center;
+}
+
+/**
+ * @brief Mesh::getBoundingMin Return minimal corner of box around all vertices of this mesh
+ * @return Minimal corner in mesh coordinates
+ */
+QVector3D Mesh::getBoundingMin()
 {
-    return numIndices * sizeof(unsigned int);
+    return boundingMin;
 }
 
-/* Get buffer index methods */
+/**
+ * @brief Mesh::getBoundingMax Return maximal corner of box around all vertices of this mesh
+ * @return Maximal corner in mesh coordinates
+ */
+QVector3D Mesh::getBoundingMax()
+{
+    return boundingMax;
+}
 
 /**
- * @brief Mesh::getVertexBufferIndex Return index of OpenGL vertex buffer
- * @return Index of buffer
+ * @brief Mesh::getBoundingRadius Return radius of sphere around all vertices of this mesh, sphere has center
+ * in center of the box.
+ * @return Radius of bounding sphere.
  */
-unsigned int Mesh::getVertexBufferIndex()
+float Mesh::getBoundingRadius()
 {
-    return vBuffer;
+    return boundingRadius;
 }
 
+/* Get buffer offset methods */
+
 /**
- * @brief Mesh::getColorBufferIndex Return index of OpenGL color buffer.
+ * @brief Mesh::getVertexOffset Return offset of vertices in model vertex buffer
+ * @return Offset in bytes
+ */
+size_t Mesh::getVertexOffset()
+{
+    return vOffset;
+}
+
+/**
+ * @brief Mesh::getColorOffset Return offset of colors in model vertex buffer.
  * @param id Identify what color buffer we want.
- * @return Index of buffer.
+ * @return Offset in bytes.
  */
-unsigned int Mesh::getColorBufferIndex(int id)
+size_t Mesh::getColorOffset(int id)
 {
-    //return cBuffer;
-    if(cBuffer.isEmpty())
+    if(cOffset.isEmpty())
         return 0;
 
-    return cBuffer.value(id);
+    return cOffset.value(id);
 }
 
 /**
- * @brief Mesh::getTextCoordBufferIndex Return index of OpenGL texture coordinate buffer.
+ * @brief Mesh::getTexCoordOffset Return offset of texture coordinates in model vertex buffer.
  * @param id Identify what texture coordinate we want.
- * @return Index of buffer.
+ * @return Offset in bytes.
  */
-unsigned int Mesh::getTextCoordBufferIndex(int id)
+size_t Mesh::getTexCoordOffset(int id)
 {
-    if(tBuffer.isEmpty())
+    if(tOffset.isEmpty())
         return 0;
 
-    return tBuffer.value(id);
+    return tOffset.value(id);
+}
+
+/**
+ * @brief Mesh::getNormalOffset Return offset of normals in model vertex buffer
+ * @return Offset in bytes
+ */
+size_t Mesh::getNormalOffset()
+{
+    return nOffset;
+}
+
+/**
+ * @brief Mesh::getIndexOffset Return offset of indices in model element buffer
+ * @param lod Level of detail, 0 for original indices.
+ * @return Offset in bytes
+ */
+size_t Mesh::getIndexOffset(int lod)
+{
+    if(lod <= 0)
+        return iOffset;
+
+    return lOffset.value(lod - 1);
+}
+
+/* Set buffer offset methods */
+
+/**
+ * @brief Mesh::clearBufferOffsets Remove all offsets, call it before this mesh is placed to new model buffers
+ */
+void Mesh::clearBufferOffsets()
+{
+    vOffset = 0;
+    nOffset = 0;
+    iOffset = 0;
+    cOffset.clear();
+    tOffset.clear();
+    lOffset.clear();
 }
 
 /**
- * @brief Mesh::getNormalBufferIndex Return index of OpenGL normal buffer
- * @return Index of buffer
+ * @brief Mesh::setVertexOffset Set offset of vertices in model vertex buffer
+ * @param offset Offset in bytes
  */
-unsigned int Mesh::getNormalBufferIndex()
+void Mesh::setVertexOffset(size_t offset)
 {
-    return nBuffer;
+    this->vOffset = offset;
 }
 
 /**
- * @brief Mesh::getIndexBufferIndex Return index of OpenGL element buffer
- * @return Index of buffer
+ * @brief Mesh::addColorOffset Add offset of next colors in model vertex buffer
+ * @param offset Offset in bytes
  */
-unsigned int Mesh::getIndexBufferIndex()
+void Mesh::addColorOffset(size_t offset)
 {
-    return iBuffer;
+    this->cOffset.append(offset);
 }
 
-/* Set buffer index methods */
+/**
+ * @brief Mesh::addTexCoordOffset Add offset of next texture coordinates in model vertex buffer.
+ * @param offset Offset in bytes.
+ */
+void Mesh::addTexCoordOffset(size_t offset)
+{
+    this->tOffset.append(offset);
+}
 
 /**
- * @brief Mesh::setVertexBufferIndex Set index of OpenGL vertex buffer for this mesh
- * @param id Index of this buffer
+ * @brief Mesh::setNormalOffset Set offset of normals in model vertex buffer
+ * @param offset Offset in bytes
  */
-void Mesh::setVertexBufferIndex(unsigned int id)
+void Mesh::setNormalOffset(size_t offset)
 {
-    this->vBuffer = id;
+    this->nOffset = offset;
 }
 
 /**
- * @brief Mesh::setColorBufferIndex Set index of OpenGL color buffer for this mesh
- * @param id Index of this buffer
+ * @brief Mesh::setIndexOffset Set offset of indices in model element buffer
+ * @param offset Offset in bytes
  */
-void Mesh::addColorBufferIndex(unsigned int id)
+void Mesh::setIndexOffset(size_t offset)
 {
-    //this->cBuffer = id;
-    this->cBuffer.append(id);
+    this->iOffset = offset;
 }
 
 /**
- * @brief Mesh::addTexCoordBufferIndex Set index of OpenGL texture buffer for this mesh.
- * @param id Index of this buffer.
+ * @brief Mesh::addLodIndexOffset Add offset of indices of next level of detail in model element buffer.
+ * Offsets are added in order of levels starting with level 1.
+ * @param offset Offset in bytes
  */
-void Mesh::addTexCoordBufferIndex(unsigned int id)
+void Mesh::addLodIndexOffset(size_t offset)
 {
-    this->tBuffer.append(id);
+    lOffset.append(offset);
 }
 
+/* Levels of detail */
+
 /**
- * @brief Mesh::setNormalBufferIndex Set index of OpenGL normal buffer for this mesh
- * @param id Index of this buffer
+ * @brief Mesh::addLod Add simplified indices as next level of detail. Simplified level uses the same vertices
+ * as original mesh, so only indices are stored.
+ * @param indices Indices of simplified triangles.
  */
-void Mesh::setNormalBufferIndex(unsigned int id)
+void Mesh::addLod(const QVector<unsigned int> &indices)
 {
-    this->nBuffer = id;
+    lodIndices.append(indices);
 }
 
 /**
- * @brief Mesh::setIndexBufferIndex Set index of OpenGL element buffer for this mesh
- * @param id Index of this buffer
+ * @brief Mesh::getLodCount Get number of levels of detail including original indices.
+ * @return Number of levels, 1 if mesh was not simplified.
  */
-void Mesh::setIndexBufferIndex(unsigned int id)
+int Mesh::getLodCount()
 {
-    this->iBuffer = id;
+    return lodIndices.size() + 1;
+}
+
+/* Order of vertices and indices */
+
+/**
+ * @brief Mesh::remapVertices Change order of vertices, all vertex attributes are moved and indices
+ * of all levels of detail are changed to new positions.
+ * @param remap New position of every vertex, must be permutation of vertices.
+ */
+void Mesh::remapVertices(const QVector<unsigned int> &remap)
+{
+    const unsigned int count = numVert / 3;
+
+    if(static_cast<unsigned int>(remap.size()) != count)
+        return;
+
+    remapAttribute(vertices, numVert, 3, remap);
+    remapAttribute(normals, numNormals, 3, remap);
+
+    for(int i = 0; i < colors.size(); ++i)
+        remapAttribute(colors.at(i), numColors.value(i), 4, remap);
+
+    for(int i = 0; i < texCoords.size(); ++i)
+        remapAttribute(texCoords.at(i), numTexCoords.value(i), 2, remap);
+
+    for(unsigned int i = 0; i < numIndices; ++i)
+        indices[i] = remap.at(indices[i]);
+
+    for(int lod = 0; lod < lodIndices.size(); ++lod)
+    {
+        QVector<unsigned int>& level = lodIndices[lod];
+
+        for(int i = 0; i < level.size(); ++i)
+            level[i] = remap.at(level.at(i));
+    }
+}
+
+/**
+ * @brief Mesh::hasShortIndices Test if indices fit to 16 bits, then element buffer stores them as unsigned shorts.
+ * @return True for 16-bit indices, false for 32-bit indices.
+ */
+bool Mesh::hasShortIndices()
+{
+    return numVert / 3 <= 65536;
+}
+
+/**
+ * @brief Mesh::getIndexSize Return size of one index in element buffer
+ * @return Size in bytes
+ */
+size_t Mesh::getIndexSize()
+{
+    return hasShortIndices() ? sizeof(unsigned short) : sizeof(unsigned int);
+}
+
+/**
+ * @brief Mesh::setAcmr Set average number of vertex cache misses per triangle.
+ * @param before Cache miss ratio of triangles in order of model file.
+ * @param after Cache miss ratio of optimized order of triangles.
+ */
+void Mesh::setAcmr(float before, float after)
+{
+    acmrBefore = before;
+    acmrAfter = after;
+}
+
+/**
+ * @brief Mesh::getAcmrBefore Return cache miss ratio of triangles in order of model file
+ * @return Average number of cache misses per triangle
+ */
+float Mesh::getAcmrBefore()
+{
+    return acmrBefore;
+}
+
+/**
+ * @brief Mesh::getAcmrAfter Return cache miss ratio of optimized order of triangles
+ * @return Average number of cache misses per triangle
+ */
+float Mesh::getAcmrAfter()
+{
+    return acmrAfter;
+}
+
+/**
+ * @brief Mesh::remapAttribute Move values of one vertex attribute to new positions of vertices.
+ * @param data Array of attribute values, can be NULL.
+ * @param number Number of floats in array.
+ * @param components Number of floats for one vertex.
+ * @param remap New position of every vertex.
+ */
+void Mesh::remapAttribute(float *data, unsigned int number, int components, const QVector<unsigned int> &remap)
+{
+    if(data == NULL || number != static_cast<unsigned int>(remap.size() * components))
+        return;
+
+    QVector<float> original(number);
+    std::copy(data, data + number, original.begin());
+
+    for(int i = 0; i < remap.size(); ++i)
+    {
+        for(int y = 0; y < components; ++y)
+            data[remap.at(i) * components + y] = original.at(i * components + y);
+    }
 }
 
 /* Work with vertex array buffers */
@@ -422,3 +627,46 @@ unsigned int Mesh::getTexCoordBuffersCount()
 {
     return texCoords.size();
 }
+
+/**
+ * @brief Mesh::computeBounds Compute box around all vertices of this mesh, its center and radius of sphere
+ * around vertices with the same center.
+ */
+void Mesh::computeBounds()
+{
+    if(vertices == NULL || numVert < 3)
+    {
+        center = QVector3D();
+        boundingMin = QVector3D();
+        boundingMax = QVector3D();
+        boundingRadius = 0.f;
+        return;
+    }
+
+    float min[3] = {vertices[0], vertices[1], vertices[2]};
+    float max[3] = {vertices[0], vertices[1], vertices[2]};
+
+    for(unsigned int i = 3; i + 2 < numVert; i += 3)
+    {
+        for(int y = 0; y < 3; ++y)
+        {
+            min[y] = qMin(min[y], vertices[i + y]);
+            max[y] = qMax(max[y], vertices[i + y]);
+        }
+    }
+
+    boundingMin = QVector3D(min[0], min[1], min[2]);
+    boundingMax = QVector3D(max[0], max[1], max[2]);
+    center = (boundingMin + boundingMax) / 2.f;
+
+    // sphere around the box center is tighter than sphere around box corners
+    float radiusSquared = 0.f;
+
+    for(unsigned int i = 0; i + 2 < numVert; i += 3)
+    {
+        QVector3D vertex(vertices[i], vertices[i + 1], vertices[i + 2]);
+        radiusSquared = qMax(radiusSquared, (vertex - center).lengthSquared());
+    }
+
+    boundingRadius = qSqrt(radiusSquared);
+}
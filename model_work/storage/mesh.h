@@ -2,7 +2,9 @@
 #define MESH_H
 
 #include <QList>
+#include <QVector>
 #include <QDebug>
+#include <QVector3D>
 
 /**
  * @brief The Mesh class contains all important data about mesh.
@@ -26,32 +28,54 @@ public:
     float* getNormals();
     float* getColors(int id = 0);
     float* getTexCoords(int id = 0);
-    unsigned int *getIndices();
+    unsigned int *getIndices(int lod = 0);
 
     unsigned int getNumberVertices();
     unsigned int getNumberColors(int id = 0);
     unsigned int getNumberTexCoords(int id =0);
     unsigned int getNumberNormals();
-    unsigned int getNumberIndices();
+    unsigned int getNumberIndices(int lod = 0);
 
     size_t getSizeVertices();
     size_t getSizeColors(int id = 0);
     size_t getSizeTexCoords(int id =0);
     size_t getSizeNormals();
-    size_t getSizeIndices();
+    size_t getSizeIndices(int lod = 0);
 
-    unsigned int getVertexBufferIndex();
-    unsigned int getColorBufferIndex(int id = 0);
-    unsigned int getTextCoordBufferIndex(int id = 0);
-    unsigned int getNormalBufferIndex();
-    unsigned int getIndexBufferIndex();
+    QVector3D getCenter();
+    QVector3D getBoundingMin();
+    QVector3D getBoundingMax();
+    float getBoundingRadius();
+
+    // offsets in model buffers (bytes)
+    size_t getVertexOffset();
+    size_t getColorOffset(int id = 0);
+    size_t getTexCoordOffset(int id = 0);
+    size_t getNormalOffset();
+    size_t getIndexOffset(int lod = 0);
 
     // set methods
-    void setVertexBufferIndex(unsigned int id);
-    void addColorBufferIndex(unsigned int id);
-    void addTexCoordBufferIndex(unsigned int id);
-    void setNormalBufferIndex(unsigned int id);
-    void setIndexBufferIndex(unsigned int id);
+    void clearBufferOffsets();
+    void setVertexOffset(size_t offset);
+    void addColorOffset(size_t offset);
+    void addTexCoordOffset(size_t offset);
+    void setNormalOffset(size_t offset);
+    void setIndexOffset(size_t offset);
+    void addLodIndexOffset(size_t offset);
+
+    // levels of detail, level 0 are original indices
+    void addLod(const QVector<unsigned int> &indices);
+    int getLodCount();
+
+    // order of vertices and size of indices in element buffer
+    void remapVertices(const QVector<unsigned int> &remap);
+    bool hasShortIndices();
+    size_t getIndexSize();
+
+    // average cache miss ratio of original and optimized order of triangles
+    void setAcmr(float before, float after);
+    float getAcmrBefore();
+    float getAcmrAfter();
 
     // vertex array methods
     unsigned int getVertexArrayBuffer();
@@ -68,6 +92,10 @@ public:
     unsigned int getColorBuffersCount();
     unsigned int getTexCoordBuffersCount();
 
+private:
+    void computeBounds();
+    static void remapAttribute(float* data, unsigned int number, int components, const QVector<unsigned int> &remap);
+
 private:
     static unsigned long counter;
     unsigned int index;
@@ -81,13 +109,23 @@ private:
     unsigned int* indices;
     QList<unsigned int> numTexCoords;
     QList<float*> texCoords;
+    QList<QVector<unsigned int> > lodIndices;
 
-    unsigned int vBuffer;
-    unsigned int nBuffer;
-    QList<unsigned int> cBuffer;
-    QList<unsigned int> tBuffer;
-    unsigned int iBuffer;
+    size_t vOffset;
+    size_t nOffset;
+    QList<size_t> cOffset;
+    QList<size_t> tOffset;
+    size_t iOffset;
+    QList<size_t> lOffset;
     unsigned int vaBuffer;
+
+    QVector3D center;
+    QVector3D boundingMin;
+    QVector3D boundingMax;
+    float boundingRadius;
+
+    float acmrBefore;
+    float acmrAfter;
 };
 
 #endif // MESH_H
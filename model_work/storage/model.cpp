@@ -1,6 +1,9 @@
 #include "model.h"
 #include "infomanager.h"
 #include "model_work/tools/assimpprogresshandler.h"
+#include "model_work/tools/meshsimplifier.h"
+#include "model_work/tools/vertexcacheoptimizer.h"
+#include <QtConcurrentMap>
 
 /**
  * @brief Model::Model Create 3D model.
@@ -9,6 +12,7 @@
 Model::Model(QObject *parent) : QObject(parent)
 {
     root = NULL;
+    lodGeneration = false;
 }
 
 /**
@@ -19,6 +23,7 @@ Model::Model(QObject *parent) : QObject(parent)
 Model::Model(QObject* parent, QString projectName) : QObject(parent)
 {
     root = NULL;
+    lodGeneration = false;
     projectNames.append(projectName);
 }
 
@@ -271,6 +276,24 @@ bool Model::isLoaded()
     return out;
 }
 
+/**
+ * @brief Model::setLodGeneration Set if simplified levels of detail are generated for meshes when model is loaded.
+ * @param generate True for generation of levels of detail.
+ */
+void Model::setLodGeneration(bool generate)
+{
+    lodGeneration = generate;
+}
+
+/**
+ * @brief Model::isLodGeneration Test if levels of detail are generated when model is loaded.
+ * @return True if levels of detail are generated, false otherwise.
+ */
+bool Model::isLodGeneration() const
+{
+    return lodGeneration;
+}
+
 /**
  * @brief Model::loadModel Hidden class for loading model with class member path. Used when loading Model from project file.
  */
@@ -364,6 +387,16 @@ bool Model::initModel(const aiScene *scene, QProgressDialog& pd)
         indices = NULL;
     }
 
+    // every mesh is optimized and simplified by one task of thread pool
+    pd.setLabelText(tr("Optimizing meshes for vertex cache"));
+    QtConcurrent::blockingMap(meshes, VertexCacheOptimizer::optimize);
+
+    if(lodGeneration)
+    {
+        pd.setLabelText(tr("Generating levels of detail"));
+        QtConcurrent::blockingMap(meshes, MeshSimplifier::generateLods);
+    }
+
     // copy nodes
     aiNode* node = scene->mRootNode;
 
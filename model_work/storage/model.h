@@ -54,6 +54,9 @@ public:
 
     bool isLoaded();
 
+    void setLodGeneration(bool generate);
+    bool isLodGeneration() const;
+
     friend QDataStream & operator<< (QDataStream& stream, const Model& model);
     friend QDataStream & operator>> (QDataStream& stream, Model& model);
 
@@ -72,6 +75,7 @@ private:
     QStringList projectNames;
     QList<Mesh*> meshes;
     ModelNode* root;
+    bool lodGeneration;
 };
 
 QDataStream & operator<< (QDataStream& stream, const Model& model);
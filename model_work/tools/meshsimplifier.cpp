@@ -0,0 +1,381 @@
+#include "meshsimplifier.h"
+#include "vertexcacheoptimizer.h"
+#include <QHash>
+#include <algorithm>
+
+// simplification stops when level would have less triangles
+#define MIN_LOD_TRIANGLES 64
+// maximal number of collapse passes for one level
+#define MAX_PASSES 32
+
+/**
+ * @brief MeshSimplifier::generateLods Generate levels of detail of mesh, every level has about half of triangles
+ * of previous level. Generation stops after maxLodLevels levels or when mesh canno't be simplified more.
+ * Can be called from worker thread, only given mesh is changed.
+ * @param mesh Mesh with vertices and indices.
+ */
+void MeshSimplifier::generateLods(Mesh *mesh)
+{
+    if(mesh == NULL || !mesh->hasVertices() || !mesh->hasIndices())
+        return;
+
+    const unsigned int vertexCount = mesh->getNumberVertices() / 3;
+    const unsigned int* base = mesh->getIndices();
+
+    QVector<unsigned int> indices(mesh->getNumberIndices());
+    std::copy(base, base + mesh->getNumberIndices(), indices.begin());
+
+    for(int level = 1; level <= maxLodLevels; ++level)
+    {
+        const int target = (indices.size() / 6) * 3;
+
+        if(target < MIN_LOD_TRIANGLES * 3)
+            break;
+
+        QVector<unsigned int> lod = simplify(mesh->getVertices(), vertexCount, indices, target);
+
+        // level which is almost the same as previous one is useless
+        if(lod.size() > indices.size() - indices.size() / 10)
+            break;
+
+        lod = VertexCacheOptimizer::optimizeTriangles(lod, vertexCount);
+
+        mesh->addLod(lod);
+        indices = lod;
+    }
+}
+
+/**
+ * @brief MeshSimplifier::simplify Simplify triangles by collapsing edges with the smallest quadric error.
+ * Collapses are done in passes, in one pass every vertex can be changed only once. Collapse is rejected
+ * when it flips some triangle around moved vertex.
+ * @param vertices Vertex positions, three floats for every vertex.
+ * @param vertexCount Number of vertices.
+ * @param indices Indices of triangles.
+ * @param targetIndexCount Wanted number of indices, result can have more indices when mesh canno't
+ * be simplified more.
+ * @return Indices of simplified triangles.
+ */
+QVector<unsigned int> MeshSimplifier::simplify(const float *vertices, unsigned int vertexCount,
+                                               const QVector<unsigned int> &indices, int targetIndexCount)
+{
+    QVector<unsigned int> result = indices;
+
+    if(vertices == NULL || vertexCount == 0 || result.size() <= targetIndexCount)
+        return result;
+
+    // planes of triangles around vertices weighted by area of triangles
+    const Quadric empty = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    QVector<Quadric> quadrics(vertexCount, empty);
+
+    for(int i = 0; i + 2 < result.size(); i += 3)
+    {
+        QVector3D p0 = getVertex(vertices, result.at(i));
+        QVector3D p1 = getVertex(vertices, result.at(i + 1));
+        QVector3D p2 = getVertex(vertices, result.at(i + 2));
+
+        QVector3D normal = QVector3D::crossProduct(p1 - p0, p2 - p0);
+        float area = normal.length();
+
+        if(area <= 0.f)
+            continue;
+
+        normal /= area;
+
+        for(int y = 0; y < 3; ++y)
+            addPlane(quadrics[result.at(i + y)], normal, p0, area);
+    }
+
+    // edges which do not have exactly two triangles are on border or on seam
+    QHash<quint64,int> edges;
+
+    for(int i = 0; i + 2 < result.size(); i += 3)
+    {
+        for(int y = 0; y < 3; ++y)
+            ++edges[getEdgeKey(result.at(i + y), result.at(i + (y + 1) % 3))];
+    }
+
+    QVector<bool> locked(vertexCount, false);
+
+    for(QHash<quint64,int>::const_iterator it = edges.constBegin(); it != edges.constEnd(); ++it)
+    {
+        if(it.value() == 2)
+            continue;
+
+        locked[static_cast<unsigned int>(it.key() >> 32)] = true;
+        locked[static_cast<unsigned int>(it.key() & 0xffffffff)] = true;
+    }
+
+    const int targetTriangles = targetIndexCount / 3;
+    QVector<unsigned int> remap(vertexCount);
+
+    for(int pass = 0; pass < MAX_PASSES && result.size() / 3 > targetTriangles; ++pass)
+    {
+        // the cheaper direction of every edge which can be collapsed, inner edge is in two triangles
+        // with opposite directions, edges on border have both vertices locked
+        QVector<Collapse> collapses;
+
+        for(int i = 0; i + 2 < result.size(); i += 3)
+        {
+            for(int y = 0; y < 3; ++y)
+            {
+                unsigned int a = result.at(i + y);
+                unsigned int b = result.at(i + (y + 1) % 3);
+
+                if(a > b)
+                    continue;
+
+                Quadric sum = quadrics.at(a);
+                addQuadric(sum, quadrics.at(b));
+
+                Collapse collapse;
+                bool valid = false;
+
+                if(!locked.at(a))
+                {
+                    collapse.from = a;
+                    collapse.to = b;
+                    collapse.error = getError(sum, getVertex(vertices, b));
+                    valid = true;
+                }
+
+                if(!locked.at(b))
+                {
+                    double error = getError(sum, getVertex(vertices, a));
+
+                    if(!valid || error < collapse.error)
+                    {
+                        collapse.from = b;
+                        collapse.to = a;
+                        collapse.error = error;
+                        valid = true;
+                    }
+                }
+
+                if(valid)
+                    collapses.append(collapse);
+            }
+        }
+
+        if(collapses.isEmpty())
+            break;
+
+        std::sort(collapses.begin(), collapses.end());
+
+        // triangles around every vertex
+        QVector<int> adjacencyOffsets(vertexCount + 1, 0);
+
+        for(int i = 0; i < result.size(); ++i)
+            ++adjacencyOffsets[result.at(i) + 1];
+
+        for(unsigned int i = 0; i < vertexCount; ++i)
+            adjacencyOffsets[i + 1] += adjacencyOffsets.at(i);
+
+        QVector<int> adjacency(result.size());
+        QVector<int> fill = adjacencyOffsets;
+
+        for(int i = 0; i < result.size(); ++i)
+            adjacency[fill[result.at(i)]++] = i / 3;
+
+        for(unsigned int i = 0; i < vertexCount; ++i)
+            remap[i] = i;
+
+        QVector<bool> touched(vertexCount, false);
+
+        // only the cheaper part of collapses is used in one pass, others are evaluated again in next pass
+        const int limit = qMax(collapses.size() / 3, 1);
+        const int removable = result.size() / 3 - targetTriangles;
+        int removed = 0;
+
+        for(int i = 0; i < limit && removed < removable; ++i)
+        {
+            const Collapse& collapse = collapses.at(i);
+
+            if(touched.at(collapse.from) || touched.at(collapse.to))
+                continue;
+
+            int collapsed = 0;
+
+            if(isFlipped(vertices, result, adjacency, adjacencyOffsets, remap, collapse, collapsed))
+                continue;
+
+            remap[collapse.from] = collapse.to;
+            addQuadric(quadrics[collapse.to], quadrics.at(collapse.from));
+
+            touched[collapse.from] = true;
+            touched[collapse.to] = true;
+
+            removed += collapsed;
+        }
+
+        if(removed == 0)
+            break;
+
+        // remove triangles degenerated by collapses
+        QVector<unsigned int> simplified;
+        simplified.reserve(result.size() - removed * 3);
+
+        for(int i = 0; i + 2 < result.size(); i += 3)
+        {
+            unsigned int a = remap.at(result.at(i));
+            unsigned int b = remap.at(result.at(i + 1));
+            unsigned int c = remap.at(result.at(i + 2));
+
+            if(a == b || b == c || a == c)
+                continue;
+
+            simplified << a << b << c;
+        }
+
+        result = simplified;
+    }
+
+    return result;
+}
+
+/**
+ * @brief MeshSimplifier::addPlane Add squared distance to plane to quadric.
+ * @param quadric Changed quadric.
+ * @param normal Normalized normal of plane.
+ * @param point Point on plane.
+ * @param weight Weight of plane.
+ */
+void MeshSimplifier::addPlane(Quadric &quadric, const QVector3D &normal, const QVector3D &point, double weight)
+{
+    const double a = normal.x();
+    const double b = normal.y();
+    const double c = normal.z();
+    const double d = -QVector3D::dotProduct(normal, point);
+
+    quadric.a2 += weight * a * a;
+    quadric.ab += weight * a * b;
+    quadric.ac += weight * a * c;
+    quadric.ad += weight * a * d;
+    quadric.b2 += weight * b * b;
+    quadric.bc += weight * b * c;
+    quadric.bd += weight * b * d;
+    quadric.c2 += weight * c * c;
+    quadric.cd += weight * c * d;
+    quadric.d2 += weight * d * d;
+}
+
+/**
+ * @brief MeshSimplifier::addQuadric Add other quadric to quadric.
+ * @param quadric Changed quadric.
+ * @param other Added quadric.
+ */
+void MeshSimplifier::addQuadric(Quadric &quadric, const Quadric &other)
+{
+    quadric.a2 += other.a2;
+    quadric.ab += other.ab;
+    quadric.ac += other.ac;
+    quadric.ad += other.ad;
+    quadric.b2 += other.b2;
+    quadric.bc += other.bc;
+    quadric.bd += other.bd;
+    quadric.c2 += other.c2;
+    quadric.cd += other.cd;
+    quadric.d2 += other.d2;
+}
+
+/**
+ * @brief MeshSimplifier::getError Get sum of weighted squared distances of point to planes of quadric.
+ * @param quadric Quadric of planes.
+ * @param point Tested point.
+ * @return Error of point, not negative.
+ */
+double MeshSimplifier::getError(const Quadric &quadric, const QVector3D &point)
+{
+    const double x = point.x();
+    const double y = point.y();
+    const double z = point.z();
+
+    double error = quadric.a2 * x * x + 2.0 * quadric.ab * x * y + 2.0 * quadric.ac * x * z + 2.0 * quadric.ad * x
+                 + quadric.b2 * y * y + 2.0 * quadric.bc * y * z + 2.0 * quadric.bd * y
+                 + quadric.c2 * z * z + 2.0 * quadric.cd * z
+                 + quadric.d2;
+
+    return qMax(error, 0.0);
+}
+
+/**
+ * @brief MeshSimplifier::getEdgeKey Get key of edge which does not depend on its direction.
+ * @param a First vertex of edge.
+ * @param b Second vertex of edge.
+ * @return Key of edge.
+ */
+quint64 MeshSimplifier::getEdgeKey(unsigned int a, unsigned int b)
+{
+    return (static_cast<quint64>(qMin(a, b)) << 32) | qMax(a, b);
+}
+
+/**
+ * @brief MeshSimplifier::getVertex Get position of vertex.
+ * @param vertices Vertex positions, three floats for every vertex.
+ * @param id Index of vertex.
+ * @return Position of vertex.
+ */
+QVector3D MeshSimplifier::getVertex(const float *vertices, unsigned int id)
+{
+    return QVector3D(vertices[id * 3], vertices[id * 3 + 1], vertices[id * 3 + 2]);
+}
+
+/**
+ * @brief MeshSimplifier::isFlipped Test if collapse turns some triangle around moved vertex to opposite side.
+ * @param vertices Vertex positions, three floats for every vertex.
+ * @param indices Indices of triangles.
+ * @param adjacency Triangles around vertices.
+ * @param adjacencyOffsets Offsets of triangles around every vertex in adjacency.
+ * @param remap Collapses done in actual pass.
+ * @param collapse Tested collapse.
+ * @param removed Number of triangles which are removed by collapse.
+ * @return True if collapse flips some triangle, false otherwise.
+ */
+bool MeshSimplifier::isFlipped(const float *vertices, const QVector<unsigned int> &indices,
+                               const QVector<int> &adjacency, const QVector<int> &adjacencyOffsets,
+                               const QVector<unsigned int> &remap, const Collapse &collapse, int &removed)
+{
+    const QVector3D source = getVertex(vertices, collapse.from);
+    const QVector3D target = getVertex(vertices, collapse.to);
+
+    removed = 0;
+
+    for(int i = adjacencyOffsets.at(collapse.from); i < adjacencyOffsets.at(collapse.from + 1); ++i)
+    {
+        const int triangle = adjacency.at(i) * 3;
+        unsigned int ids[3];
+        int corner = 0;
+
+        for(int y = 0; y < 3; ++y)
+        {
+            ids[y] = remap.at(indices.at(triangle + y));
+
+            if(ids[y] == collapse.from)
+                corner = y;
+        }
+
+        // triangle with collapsed edge disappears
+        if(ids[0] == collapse.to || ids[1] == collapse.to || ids[2] == collapse.to)
+        {
+            ++removed;
+            continue;
+        }
+
+        const unsigned int next = ids[(corner + 1) % 3];
+        const unsigned int last = ids[(corner + 2) % 3];
+
+        if(next == last)
+            continue;
+
+        const QVector3D p1 = getVertex(vertices, next);
+        const QVector3D p2 = getVertex(vertices, last);
+
+        QVector3D before = QVector3D::crossProduct(p1 - source, p2 - source);
+        QVector3D after = QVector3D::crossProduct(p1 - target, p2 - target);
+
+        if(QVector3D::dotProduct(before, after) <= 0.f)
+            return true;
+    }
+
+    return false;
+}
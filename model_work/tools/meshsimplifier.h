@@ -0,0 +1,55 @@
+#ifndef MESHSIMPLIFIER_H
+#define MESHSIMPLIFIER_H
+
+#include <QVector>
+#include "model_work/storage/mesh.h"
+
+/**
+ * @brief The MeshSimplifier class Generation of levels of detail by quadric edge collapse. Vertices are only moved
+ * to position of other vertex of the edge, so simplified levels share vertex data with original mesh and differ
+ * only in indices. Border vertices (also seams where vertices are split by normals or coordinates) are not moved.
+ * Triangles of every level are reordered for vertex cache.
+ */
+class MeshSimplifier
+{
+public:
+    const static int maxLodLevels = 4;
+
+    static void generateLods(Mesh* mesh);
+    static QVector<unsigned int> simplify(const float* vertices, unsigned int vertexCount,
+                                          const QVector<unsigned int> &indices, int targetIndexCount);
+
+private:
+    /**
+     * @brief The Quadric struct Symmetric 4x4 matrix of squared distances to planes, only upper triangle is stored.
+     */
+    struct Quadric {
+        double a2, ab, ac, ad, b2, bc, bd, c2, cd, d2;
+    };
+
+    /**
+     * @brief The Collapse struct Move of vertex from to position of vertex to with error of this move.
+     */
+    struct Collapse {
+        unsigned int from;
+        unsigned int to;
+        double error;
+
+        bool operator<(const Collapse& other) const
+        {
+            return error < other.error;
+        }
+    };
+
+    static void addPlane(Quadric &quadric, const QVector3D &normal, const QVector3D &point, double weight);
+    static void addQuadric(Quadric &quadric, const Quadric &other);
+    static double getError(const Quadric &quadric, const QVector3D &point);
+    static quint64 getEdgeKey(unsigned int a, unsigned int b);
+
+    static QVector3D getVertex(const float* vertices, unsigned int id);
+    static bool isFlipped(const float* vertices, const QVector<unsigned int> &indices,
+                          const QVector<int> &adjacency, const QVector<int> &adjacencyOffsets,
+                          const QVector<unsigned int> &remap, const Collapse &collapse, int &removed);
+};
+
+#endif // MESHSIMPLIFIER_H
@@ -0,0 +1,272 @@
+#include "vertexcacheoptimizer.h"
+#include <qmath.h>
+#include <algorithm>
+
+// size of modelled LRU cache and weights of vertex score from Forsyth's algorithm
+#define CACHE_SIZE 32
+#define CACHE_DECAY_POWER 1.5f
+#define LAST_TRIANGLE_SCORE 0.75f
+#define VALENCE_BOOST_SCALE 2.0f
+#define VALENCE_BOOST_POWER 0.5f
+
+// size of simulated FIFO cache for measuring of cache miss ratio
+#define FIFO_CACHE_SIZE 16
+
+/**
+ * @brief VertexCacheOptimizer::optimize Reorder triangles of mesh for vertex cache and then vertices in order
+ * of first use. Optimized order is kept only when it has lower cache miss ratio. Both ratios are stored in mesh.
+ * Must be called before levels of detail are generated. Can be called from worker thread, only given mesh
+ * is changed.
+ * @param mesh Mesh with vertices and indices.
+ */
+void VertexCacheOptimizer::optimize(Mesh *mesh)
+{
+    if(mesh == NULL || !mesh->hasVertices() || !mesh->hasIndices())
+        return;
+
+    const unsigned int vertexCount = mesh->getNumberVertices() / 3;
+    unsigned int* data = mesh->getIndices();
+
+    QVector<unsigned int> indices(mesh->getNumberIndices());
+    std::copy(data, data + mesh->getNumberIndices(), indices.begin());
+
+    const float before = getAcmr(indices, vertexCount);
+    float after = before;
+
+    QVector<unsigned int> optimized = optimizeTriangles(indices, vertexCount);
+    float acmr = getAcmr(optimized, vertexCount);
+
+    if(acmr < before)
+    {
+        std::copy(optimized.constBegin(), optimized.constEnd(), data);
+        indices = optimized;
+        after = acmr;
+    }
+
+    mesh->remapVertices(getFetchRemap(indices, vertexCount));
+    mesh->setAcmr(before, after);
+}
+
+/**
+ * @brief VertexCacheOptimizer::optimizeTriangles Reorder triangles to reuse transformed vertices. Triangles
+ * are added greedily by score of their vertices, score is higher for vertices which are in modelled cache
+ * and for vertices with few remaining triangles.
+ * @param indices Indices of triangles.
+ * @param vertexCount Number of vertices.
+ * @return Indices of the same triangles in new order.
+ */
+QVector<unsigned int> VertexCacheOptimizer::optimizeTriangles(const QVector<unsigned int> &indices,
+                                                              unsigned int vertexCount)
+{
+    const int triangleCount = indices.size() / 3;
+
+    if(triangleCount == 0 || vertexCount == 0)
+        return indices;
+
+    // remaining triangles of every vertex
+    QVector<int> valence(vertexCount, 0);
+
+    for(int i = 0; i < triangleCount * 3; ++i)
+        ++valence[indices.at(i)];
+
+    QVector<int> adjacencyOffsets(vertexCount + 1, 0);
+
+    for(unsigned int i = 0; i < vertexCount; ++i)
+        adjacencyOffsets[i + 1] = adjacencyOffsets.at(i) + valence.at(i);
+
+    QVector<int> adjacency(triangleCount * 3);
+    QVector<int> fill = adjacencyOffsets;
+
+    for(int i = 0; i < triangleCount * 3; ++i)
+        adjacency[fill[indices.at(i)]++] = i / 3;
+
+    QVector<int> cachePosition(vertexCount, -1);
+    QVector<float> vertexScore(vertexCount);
+
+    for(unsigned int i = 0; i < vertexCount; ++i)
+        vertexScore[i] = getVertexScore(-1, valence.at(i));
+
+    QVector<float> triangleScore(triangleCount);
+    QVector<bool> emitted(triangleCount, false);
+    int best = 0;
+
+    for(int i = 0; i < triangleCount; ++i)
+    {
+        triangleScore[i] = vertexScore.at(indices.at(i * 3)) + vertexScore.at(indices.at(i * 3 + 1)) +
+                           vertexScore.at(indices.at(i * 3 + 2));
+
+        if(triangleScore.at(i) > triangleScore.at(best))
+            best = i;
+    }
+
+    QVector<unsigned int> result;
+    result.reserve(triangleCount * 3);
+
+    QVector<unsigned int> cache;
+    int scanPosition = 0;
+
+    while(best >= 0)
+    {
+        emitted[best] = true;
+
+        // vertices of added triangle move to front of cache
+        QVector<unsigned int> newCache;
+
+        for(int y = 0; y < 3; ++y)
+        {
+            unsigned int vertex = indices.at(best * 3 + y);
+            result.append(vertex);
+            --valence[vertex];
+
+            if(!newCache.contains(vertex))
+                newCache.append(vertex);
+        }
+
+        foreach(unsigned int vertex, cache)
+        {
+            if(!newCache.contains(vertex))
+                newCache.append(vertex);
+        }
+
+        for(int i = 0; i < newCache.size(); ++i)
+        {
+            unsigned int vertex = newCache.at(i);
+            cachePosition[vertex] = (i < CACHE_SIZE) ? i : -1;
+            vertexScore[vertex] = getVertexScore(cachePosition.at(vertex), valence.at(vertex));
+        }
+
+        // scores of triangles around changed vertices, next triangle is the best one around cached vertices
+        best = -1;
+        float bestScore = -1.f;
+
+        foreach(unsigned int vertex, newCache)
+        {
+            for(int i = adjacencyOffsets.at(vertex); i < adjacencyOffsets.at(vertex + 1); ++i)
+            {
+                int triangle = adjacency.at(i);
+
+                if(emitted.at(triangle))
+                    continue;
+
+                float score = vertexScore.at(indices.at(triangle * 3)) +
+                              vertexScore.at(indices.at(triangle * 3 + 1)) +
+                              vertexScore.at(indices.at(triangle * 3 + 2));
+                triangleScore[triangle] = score;
+
+                if(cachePosition.at(vertex) >= 0 && score > bestScore)
+                {
+                    best = triangle;
+                    bestScore = score;
+                }
+            }
+        }
+
+        if(newCache.size() > CACHE_SIZE)
+            newCache.resize(CACHE_SIZE);
+
+        cache = newCache;
+
+        // cache does not touch any remaining triangle, continue with next one in original order
+        if(best < 0)
+        {
+            while(scanPosition < triangleCount && emitted.at(scanPosition))
+                ++scanPosition;
+
+            if(scanPosition < triangleCount)
+                best = scanPosition;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief VertexCacheOptimizer::getFetchRemap Get new positions of vertices in order of their first use
+ * by triangles. Unused vertices are placed after used ones.
+ * @param indices Indices of triangles.
+ * @param vertexCount Number of vertices.
+ * @return New position of every vertex.
+ */
+QVector<unsigned int> VertexCacheOptimizer::getFetchRemap(const QVector<unsigned int> &indices,
+                                                          unsigned int vertexCount)
+{
+    QVector<unsigned int> remap(vertexCount, vertexCount);
+    unsigned int next = 0;
+
+    for(int i = 0; i < indices.size(); ++i)
+    {
+        unsigned int vertex = indices.at(i);
+
+        if(remap.at(vertex) == vertexCount)
+            remap[vertex] = next++;
+    }
+
+    for(unsigned int i = 0; i < vertexCount; ++i)
+    {
+        if(remap.at(i) == vertexCount)
+            remap[i] = next++;
+    }
+
+    return remap;
+}
+
+/**
+ * @brief VertexCacheOptimizer::getAcmr Get average cache miss ratio, number of vertex transformations per triangle
+ * with FIFO post-transform cache. The best possible value is about 0.5, the worst value is 3.
+ * @param indices Indices of triangles.
+ * @param vertexCount Number of vertices.
+ * @return Average number of cache misses per triangle.
+ */
+float VertexCacheOptimizer::getAcmr(const QVector<unsigned int> &indices, unsigned int vertexCount)
+{
+    const int triangleCount = indices.size() / 3;
+
+    if(triangleCount == 0)
+        return 0.f;
+
+    // time of insertion of vertex to cache
+    QVector<int> inserted(vertexCount, -1);
+    int time = 0;
+    int misses = 0;
+
+    for(int i = 0; i < triangleCount * 3; ++i)
+    {
+        unsigned int vertex = indices.at(i);
+
+        if(inserted.at(vertex) >= 0 && time - inserted.at(vertex) < FIFO_CACHE_SIZE)
+            continue;
+
+        inserted[vertex] = time++;
+        ++misses;
+    }
+
+    return static_cast<float>(misses) / triangleCount;
+}
+
+/**
+ * @brief VertexCacheOptimizer::getVertexScore Get score of vertex by its position in cache and number
+ * of its remaining triangles.
+ * @param cachePosition Position in cache, -1 if vertex is not in cache.
+ * @param valence Number of remaining triangles.
+ * @return Score of vertex, -1 if vertex does not have remaining triangles.
+ */
+float VertexCacheOptimizer::getVertexScore(int cachePosition, int valence)
+{
+    if(valence <= 0)
+        return -1.f;
+
+    float score = 0.f;
+
+    if(cachePosition >= 0)
+    {
+        // vertices of the last triangle have fixed score, so the next triangle does not reuse all of them
+        if(cachePosition < 3)
+            score = LAST_TRIANGLE_SCORE;
+        else
+            score = qPow(1.f - static_cast<float>(cachePosition - 3) / (CACHE_SIZE - 3), CACHE_DECAY_POWER);
+    }
+
+    score += VALENCE_BOOST_SCALE * qPow(static_cast<float>(valence), -VALENCE_BOOST_POWER);
+
+    return score;
+}
@@ -0,0 +1,24 @@
+#ifndef VERTEXCACHEOPTIMIZER_H
+#define VERTEXCACHEOPTIMIZER_H
+
+#include <QVector>
+#include "model_work/storage/mesh.h"
+
+/**
+ * @brief The VertexCacheOptimizer class Reordering of triangles for post-transform vertex cache (Forsyth's linear
+ * speed algorithm) and reordering of vertices by first use for vertex fetch locality. Quality of order is
+ * measured as average cache miss ratio (ACMR) of simulated FIFO cache.
+ */
+class VertexCacheOptimizer
+{
+public:
+    static void optimize(Mesh* mesh);
+    static QVector<unsigned int> optimizeTriangles(const QVector<unsigned int> &indices, unsigned int vertexCount);
+    static QVector<unsigned int> getFetchRemap(const QVector<unsigned int> &indices, unsigned int vertexCount);
+    static float getAcmr(const QVector<unsigned int> &indices, unsigned int vertexCount);
+
+private:
+    static float getVertexScore(int cachePosition, int valence);
+};
+
+#endif // VERTEXCACHEOPTIMIZER_H
@@ -21,6 +21,7 @@ void OGL_layout::createOpenGLWindow(QTextEdit *logWindow)
     glFormat.setVersion( 3, 3); // OpenGL core version
     glFormat.setProfile(QGLFormat::CoreProfile);
     glFormat.setSampleBuffers(true);
+    glFormat.setSwapInterval(1); // vertical synchronization
 
     ogl_window = new OGLwindow(glFormat, logWindow, this);
 
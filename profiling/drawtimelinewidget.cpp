@@ -0,0 +1,162 @@
+#include "drawtimelinewidget.h"
+#include <QPainter>
+#include <QHelpEvent>
+#include <QToolTip>
+
+// spaces around chart in pixels
+#define TIMELINE_MARGIN 4
+#define AXIS_HEIGHT 16
+
+/**
+ * @brief DrawTimelineWidget::DrawTimelineWidget Create empty timeline.
+ * @param parent Parent of this QWidget.
+ */
+DrawTimelineWidget::DrawTimelineWidget(QWidget *parent) :
+    QWidget(parent),
+    frameTime(0)
+{
+    setMinimumHeight(80);
+}
+
+/**
+ * @brief DrawTimelineWidget::setTimings Set draws of new frame and repaint the chart.
+ * @param timings Draws with times from the frame start in nanoseconds.
+ * @param frameTime Time from the frame start to the end of the last draw in nanoseconds.
+ */
+void DrawTimelineWidget::setTimings(const QVector<DrawTimestamps::DrawTiming> &timings, qint64 frameTime)
+{
+    this->timings = timings;
+    this->frameTime = frameTime;
+
+    // rows in order of first draw of shader program
+    programs.clear();
+
+    foreach(const DrawTimestamps::DrawTiming& draw, timings)
+    {
+        if(!programs.contains(draw.program))
+            programs.append(draw.program);
+    }
+
+    update();
+}
+
+/**
+ * @brief DrawTimelineWidget::paintEvent Paint rows of shader programs with bars of their draws and time axis.
+ * @param event Paint event.
+ */
+void DrawTimelineWidget::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+
+    QPainter painter(this);
+    painter.fillRect(rect(), palette().base());
+
+    if(timings.isEmpty() || frameTime <= 0)
+    {
+        painter.drawText(rect(), Qt::AlignCenter, tr("No measured draws"));
+        return;
+    }
+
+    const int labelWidth = getLabelWidth();
+    const int rowHeight = getRowHeight();
+
+    for(int i = 0; i < programs.size(); ++i)
+    {
+        QRect label(TIMELINE_MARGIN, TIMELINE_MARGIN + i * rowHeight, labelWidth, rowHeight);
+        painter.drawText(label, Qt::AlignVCenter | Qt::AlignLeft, programs.at(i));
+    }
+
+    for(int i = 0; i < timings.size(); ++i)
+    {
+        const int row = programs.indexOf(timings.at(i).program);
+        QColor color = QColor::fromHsv((row * 67) % 360, 160, 220);
+
+        painter.fillRect(getBarRect(i), color);
+    }
+
+    // time axis under rows
+    const int axisY = height() - AXIS_HEIGHT;
+    const int left = TIMELINE_MARGIN + labelWidth;
+    const int right = width() - TIMELINE_MARGIN;
+
+    painter.drawLine(left, axisY, right, axisY);
+    painter.drawText(QRect(left, axisY, right - left, AXIS_HEIGHT), Qt::AlignLeft | Qt::AlignVCenter, "0");
+    painter.drawText(QRect(left, axisY, right - left, AXIS_HEIGHT), Qt::AlignRight | Qt::AlignVCenter,
+                     QString("%1 " + QString::fromUtf8("µ") + "s").arg(frameTime / 1000.0, 0, 'f', 1));
+}
+
+/**
+ * @brief DrawTimelineWidget::event Show tool tip with node, mesh, shader program and time of draw under cursor.
+ * @param event Received event.
+ * @return True if event was handled, false otherwise.
+ */
+bool DrawTimelineWidget::event(QEvent *event)
+{
+    if(event->type() != QEvent::ToolTip)
+        return QWidget::event(event);
+
+    QHelpEvent* help = static_cast<QHelpEvent*>(event);
+
+    for(int i = 0; i < timings.size(); ++i)
+    {
+        if(!getBarRect(i).adjusted(-1, 0, 1, 0).contains(help->pos()))
+            continue;
+
+        const DrawTimestamps::DrawTiming& draw = timings.at(i);
+        QToolTip::showText(help->globalPos(), tr("Node %1, mesh %2, %3\n%4 instances, %5 %6s")
+                           .arg(draw.nodeIndex).arg(draw.meshIndex).arg(draw.program).arg(draw.instanceCount)
+                           .arg((draw.end - draw.start) / 1000.0, 0, 'f', 1).arg(QString::fromUtf8("µ")));
+        return true;
+    }
+
+    QToolTip::hideText();
+    event->ignore();
+
+    return true;
+}
+
+/**
+ * @brief DrawTimelineWidget::getBarRect Get rectangle of draw in the chart.
+ * @param draw Index of draw.
+ * @return Rectangle of the bar.
+ */
+QRectF DrawTimelineWidget::getBarRect(int draw) const
+{
+    const DrawTimestamps::DrawTiming& timing = timings.at(draw);
+    const int rowHeight = getRowHeight();
+    const int row = programs.indexOf(timing.program);
+
+    const double left = TIMELINE_MARGIN + getLabelWidth();
+    const double scale = (width() - TIMELINE_MARGIN - left) / static_cast<double>(frameTime);
+
+    // very short draws are still visible
+    const double start = left + timing.start * scale;
+    const double length = qMax((timing.end - timing.start) * scale, 1.0);
+
+    return QRectF(start, TIMELINE_MARGIN + row * rowHeight + 1, length, rowHeight - 2);
+}
+
+/**
+ * @brief DrawTimelineWidget::getLabelWidth Get width of column with names of shader programs.
+ * @return Width in pixels.
+ */
+int DrawTimelineWidget::getLabelWidth() const
+{
+    int labelWidth = 0;
+
+    foreach(const QString& program, programs)
+        labelWidth = qMax(labelWidth, fontMetrics().width(program));
+
+    return labelWidth + TIMELINE_MARGIN;
+}
+
+/**
+ * @brief DrawTimelineWidget::getRowHeight Get height of row of one shader program, rows fill the widget.
+ * @return Height in pixels.
+ */
+int DrawTimelineWidget::getRowHeight() const
+{
+    const int rows = qMax(programs.size(), 1);
+
+    return qMax((height() - AXIS_HEIGHT - TIMELINE_MARGIN) / rows, 4);
+}
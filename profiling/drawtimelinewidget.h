@@ -0,0 +1,35 @@
+#ifndef DRAWTIMELINEWIDGET_H
+#define DRAWTIMELINEWIDGET_H
+
+#include <QWidget>
+#include <QStringList>
+#include "drawtimestamps.h"
+
+/**
+ * @brief The DrawTimelineWidget class Gantt chart of GPU draws in one frame. Every shader program has its own
+ * row, draws are bars placed by their timestamps from the frame start.
+ */
+class DrawTimelineWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit DrawTimelineWidget(QWidget *parent = 0);
+
+    void setTimings(const QVector<DrawTimestamps::DrawTiming> &timings, qint64 frameTime);
+
+protected:
+    virtual void paintEvent(QPaintEvent *event);
+    virtual bool event(QEvent *event);
+
+private:
+    QRectF getBarRect(int draw) const;
+    int getLabelWidth() const;
+    int getRowHeight() const;
+
+    QVector<DrawTimestamps::DrawTiming> timings;
+    QStringList programs;
+    qint64 frameTime;
+};
+
+#endif // DRAWTIMELINEWIDGET_H
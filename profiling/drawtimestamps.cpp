@@ -0,0 +1,210 @@
+#include "drawtimestamps.h"
+
+/**
+ * @brief DrawTimestamps::DrawTimestamps Create empty ring of timestamp queries.
+ */
+DrawTimestamps::DrawTimestamps() :
+    current(0),
+    canUse(false),
+    frameTime(0)
+{
+    for(int i = 0; i < ringSize; ++i)
+    {
+        frames[i].used = 0;
+        frames[i].pending = false;
+    }
+}
+
+/**
+ * @brief DrawTimestamps::beginFrame Move to next slot of ring. Slot can be used only when results
+ * of its previous frame were read, otherwise frame is not measured.
+ * @return True if frame can be measured, false otherwise.
+ */
+bool DrawTimestamps::beginFrame()
+{
+    current = (current + 1) % ringSize;
+    canUse = !frames[current].pending;
+
+    if(canUse)
+    {
+        frames[current].used = 0;
+        frames[current].draws.clear();
+    }
+
+    return canUse;
+}
+
+/**
+ * @brief DrawTimestamps::endFrame Mark queries of actual frame as waiting for results.
+ */
+void DrawTimestamps::endFrame()
+{
+    if(canUse && !frames[current].draws.isEmpty())
+        frames[current].pending = true;
+
+    canUse = false;
+}
+
+/**
+ * @brief DrawTimestamps::clear Forget all queries and measured draws. OpenGL queries must be deleted before.
+ */
+void DrawTimestamps::clear()
+{
+    for(int i = 0; i < ringSize; ++i)
+    {
+        frames[i].queries.clear();
+        frames[i].draws.clear();
+        frames[i].used = 0;
+        frames[i].pending = false;
+    }
+
+    canUse = false;
+    timings.clear();
+    frameTime = 0;
+}
+
+/**
+ * @brief DrawTimestamps::isUsable Test if timestamps can be recorded in actual frame.
+ * @return True if actual frame is measured, false otherwise.
+ */
+bool DrawTimestamps::isUsable() const
+{
+    return canUse;
+}
+
+/**
+ * @brief DrawTimestamps::needsQuery Test if all queries of actual slot are used and new one must be added.
+ * @return True if new query must be added, false otherwise.
+ */
+bool DrawTimestamps::needsQuery() const
+{
+    return frames[current].used == frames[current].queries.size();
+}
+
+/**
+ * @brief DrawTimestamps::addQuery Add new query to actual slot of ring. Query is kept until clear is called.
+ * @param queryId Id of created OpenGL query.
+ */
+void DrawTimestamps::addQuery(const uint queryId)
+{
+    frames[current].queries.append(queryId);
+}
+
+/**
+ * @brief DrawTimestamps::nextQuery Return next unused query of actual frame and mark it as used.
+ * The first query of frame is the frame start, then follow begin and end of every draw.
+ * @return OpenGL query id.
+ */
+uint DrawTimestamps::nextQuery()
+{
+    Frame& frame = frames[current];
+
+    return frame.queries.at(frame.used++);
+}
+
+/**
+ * @brief DrawTimestamps::addDraw Tag the last two used queries of actual frame with measured draw.
+ * @param nodeIndex Index of node with drawn mesh.
+ * @param meshIndex Index of drawn mesh.
+ * @param program Name of shader program.
+ * @param instanceCount Number of drawn instances.
+ */
+void DrawTimestamps::addDraw(unsigned int nodeIndex, unsigned int meshIndex, const QString &program,
+                             int instanceCount)
+{
+    DrawTiming draw;
+    draw.nodeIndex = nodeIndex;
+    draw.meshIndex = meshIndex;
+    draw.program = program;
+    draw.instanceCount = instanceCount;
+    draw.start = 0;
+    draw.end = 0;
+
+    frames[current].draws.append(draw);
+}
+
+/**
+ * @brief DrawTimestamps::getOldestPending Get the oldest slot which waits for results.
+ * @return Index of slot, -1 if no slot waits.
+ */
+int DrawTimestamps::getOldestPending() const
+{
+    for(int i = 1; i <= ringSize; ++i)
+    {
+        const int frame = (current + i) % ringSize;
+
+        if(frames[frame].pending)
+            return frame;
+    }
+
+    return -1;
+}
+
+/**
+ * @brief DrawTimestamps::getFrameQueries Get queries used in frame of given slot.
+ * @param frame Index of slot.
+ * @return OpenGL query ids in order of issuing.
+ */
+QVector<uint> DrawTimestamps::getFrameQueries(int frame) const
+{
+    return frames[frame].queries.mid(0, frames[frame].used);
+}
+
+/**
+ * @brief DrawTimestamps::setFrameTimestamps Set results of frame as the newest timings and release its slot.
+ * @param frame Index of slot.
+ * @param timestamps Results of all used queries of the frame in nanoseconds.
+ */
+void DrawTimestamps::setFrameTimestamps(int frame, const QVector<qint64> &timestamps)
+{
+    Frame& slot = frames[frame];
+    slot.pending = false;
+
+    if(timestamps.size() != slot.draws.size() * 2 + 1)
+        return;
+
+    const qint64 frameStart = timestamps.at(0);
+
+    timings = slot.draws;
+    frameTime = 0;
+
+    for(int i = 0; i < timings.size(); ++i)
+    {
+        timings[i].start = timestamps.at(i * 2 + 1) - frameStart;
+        timings[i].end = timestamps.at(i * 2 + 2) - frameStart;
+        frameTime = qMax(frameTime, timings.at(i).end);
+    }
+}
+
+/**
+ * @brief DrawTimestamps::getAllQueries Get all queries of all slots, for deleting of OpenGL objects.
+ * @return OpenGL query ids.
+ */
+QVector<uint> DrawTimestamps::getAllQueries() const
+{
+    QVector<uint> ret;
+
+    for(int i = 0; i < ringSize; ++i)
+        ret += frames[i].queries;
+
+    return ret;
+}
+
+/**
+ * @brief DrawTimestamps::getTimings Get draws of the newest frame with available results.
+ * @return Measured draws in order of drawing.
+ */
+QVector<DrawTimestamps::DrawTiming> DrawTimestamps::getTimings() const
+{
+    return timings;
+}
+
+/**
+ * @brief DrawTimestamps::getFrameTime Get time from the frame start to the end of the last draw
+ * of the newest measured frame.
+ * @return Time in nanoseconds.
+ */
+qint64 DrawTimestamps::getFrameTime() const
+{
+    return frameTime;
+}
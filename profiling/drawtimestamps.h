@@ -0,0 +1,67 @@
+#ifndef DRAWTIMESTAMPS_H
+#define DRAWTIMESTAMPS_H
+
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief The DrawTimestamps class Ring of OpenGL timestamp queries of single draws. Every frame has its own slot with
+ * timestamp of frame start and two timestamps around every draw, tagged by node, mesh and shader program. Queries are
+ * reused in later frames and results are read few frames later, so reading never waits for GPU.
+ */
+class DrawTimestamps
+{
+public:
+    const static int ringSize = 4;
+
+    /**
+     * @brief The DrawTiming struct Measured draw, times are in nanoseconds from the start of frame.
+     */
+    struct DrawTiming {
+        unsigned int nodeIndex;
+        unsigned int meshIndex;
+        QString program;
+        int instanceCount;
+        qint64 start;
+        qint64 end;
+    };
+
+    DrawTimestamps();
+
+    bool beginFrame();
+    void endFrame();
+    void clear();
+
+    bool isUsable() const;
+    bool needsQuery() const;
+    void addQuery(const uint queryId);
+    uint nextQuery();
+    void addDraw(unsigned int nodeIndex, unsigned int meshIndex, const QString &program, int instanceCount);
+
+    int getOldestPending() const;
+    QVector<uint> getFrameQueries(int frame) const;
+    void setFrameTimestamps(int frame, const QVector<qint64> &timestamps);
+
+    QVector<uint> getAllQueries() const;
+    QVector<DrawTiming> getTimings() const;
+    qint64 getFrameTime() const;
+
+private:
+    /**
+     * @brief The Frame struct Queries and draws of one frame, used queries are at the beginning.
+     */
+    struct Frame {
+        QVector<uint> queries;
+        QVector<DrawTiming> draws;
+        int used;
+        bool pending;
+    };
+
+    Frame frames[ringSize];
+    int current;
+    bool canUse;
+    QVector<DrawTiming> timings;
+    qint64 frameTime;
+};
+
+#endif // DRAWTIMESTAMPS_H
@@ -3,12 +3,16 @@
 HEADERS += \
     profiling/profilewidget.h \
     profiling/timeseriesdata.h \
-    profiling/timequerystorage.h
+    profiling/timequerystorage.h \
+    profiling/drawtimestamps.h \
+    profiling/drawtimelinewidget.h
 
 SOURCES += \
     profiling/profilewidget.cpp \
     profiling/timeseriesdata.cpp \
-    profiling/timequerystorage.cpp
+    profiling/timequerystorage.cpp \
+    profiling/drawtimestamps.cpp \
+    profiling/drawtimelinewidget.cpp
 
 FORMS += \
     profiling/profilewidget.ui
@@ -3,9 +3,22 @@
 #include <qwt.h>
 #include <qwt_plot.h>
 #include <qwt_plot_curve.h>
+#include <QHeaderView>
+#include <QMap>
 
 #define ALL tr("ALL")
 
+// columns of table with the costliest draws
+#define NODE_COL 0
+#define MESH_COL 1
+#define PROGRAM_COL 2
+#define INSTANCES_COL 3
+#define TIME_COL 4
+#define COL_NUM 5
+
+// number of draws in the table
+#define TOP_DRAWS 20
+
 /**
  * @brief ProfileWidget::ProfileWidget Constructor
  * @param parent Parent of this QObject child
@@ -13,7 +26,8 @@
 ProfileWidget::ProfileWidget(QWidget *parent) :
     QWidget(parent),
     ui(new Ui::ProfileWidget),
-    numberDrawings(100)
+    numberDrawings(100),
+    ogl(NULL)
 {
     ui->setupUi(this);
 
@@ -42,12 +56,22 @@ ProfileWidget::ProfileWidget(QWidget *parent) :
 
     allSet = true;
 
+    ui->drawTable->setColumnCount(COL_NUM);
+    QStringList names;
+    names << tr("Node") << tr("Mesh") << tr("Program") << tr("Instances")
+          << QString("GPU " + QString::fromUtf8("µ") + "s");
+    ui->drawTable->setHorizontalHeaderLabels(names);
+    ui->drawTable->verticalHeader()->hide();
+    ui->drawTable->sortByColumn(TIME_COL, Qt::DescendingOrder);
+    ui->drawTable->setSortingEnabled(true);
+
     QTimer* timer = new QTimer(this);
     timer->setSingleShot(false);
     timer->start(500);
 
     connect(timer,SIGNAL(timeout()),this,SLOT(getNewValues()));
     connect(ui->shProgComboBox,SIGNAL(currentIndexChanged(QString)),this,SLOT(setShaderProgram(QString)));
+    connect(ui->tabWidget,SIGNAL(currentChanged(int)),this,SLOT(updateDrawTiming()));
 }
 
 /**
@@ -65,6 +89,89 @@ ProfileWidget::~ProfileWidget()
 void ProfileWidget::setGLWindow(OGLwindow *window)
 {
     this->ogl = window;
+
+    updateDrawTiming();
+}
+
+/**
+ * @brief ProfileWidget::showEvent Start timing of single draws if their tab is shown.
+ * @param event Show event.
+ */
+void ProfileWidget::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+    updateDrawTiming();
+}
+
+/**
+ * @brief ProfileWidget::hideEvent Stop timing of single draws, nobody can see them.
+ * @param event Hide event.
+ */
+void ProfileWidget::hideEvent(QHideEvent *event)
+{
+    QWidget::hideEvent(event);
+    updateDrawTiming();
+}
+
+/**
+ * @brief ProfileWidget::updateDrawTiming Record timestamps of single draws only when the tab with draws is visible.
+ */
+void ProfileWidget::updateDrawTiming()
+{
+    if(ogl == NULL)
+        return;
+
+    ogl->setDrawTiming(isVisible() && ui->tabWidget->currentWidget() == ui->drawsTab);
+}
+
+/**
+ * @brief ProfileWidget::refreshDraws Show the costliest draws of the newest measured frame in table and all its draws
+ * in timeline.
+ */
+void ProfileWidget::refreshDraws()
+{
+    const RenderCore* core = ogl->getRenderCore();
+    QVector<DrawTimestamps::DrawTiming> timings = core->getDrawTimings();
+
+    ui->timelineWidget->setTimings(timings, core->getDrawFrameTime());
+
+    // the costliest draws first
+    QMap<qint64, int> costs;
+
+    for(int i = 0; i < timings.size(); ++i)
+        costs.insertMulti(timings.at(i).end - timings.at(i).start, i);
+
+    QList<int> top = costs.values();
+
+    while(top.size() > TOP_DRAWS)
+        top.removeFirst();
+
+    // sorting during filling would move rows
+    ui->drawTable->setSortingEnabled(false);
+    ui->drawTable->clearContents();
+    ui->drawTable->setRowCount(top.size());
+
+    for(int row = 0; row < top.size(); ++row)
+    {
+        const DrawTimestamps::DrawTiming& draw = timings.at(top.at(row));
+
+        QTableWidgetItem* time = new QTableWidgetItem();
+        time->setData(Qt::DisplayRole, (draw.end - draw.start) / 1000.0);
+        QTableWidgetItem* node = new QTableWidgetItem();
+        node->setData(Qt::DisplayRole, draw.nodeIndex);
+        QTableWidgetItem* mesh = new QTableWidgetItem();
+        mesh->setData(Qt::DisplayRole, draw.meshIndex);
+        QTableWidgetItem* instances = new QTableWidgetItem();
+        instances->setData(Qt::DisplayRole, draw.instanceCount);
+
+        ui->drawTable->setItem(row, NODE_COL, node);
+        ui->drawTable->setItem(row, MESH_COL, mesh);
+        ui->drawTable->setItem(row, PROGRAM_COL, new QTableWidgetItem(draw.program));
+        ui->drawTable->setItem(row, INSTANCES_COL, instances);
+        ui->drawTable->setItem(row, TIME_COL, time);
+    }
+
+    ui->drawTable->setSortingEnabled(true);
 }
 
 /**
@@ -155,10 +262,21 @@ void ProfileWidget::refreshStats()
 }
 
 /**
- * @brief ProfileWidget::getNewValues Get new values from measured objects.
+ * @brief ProfileWidget::getNewValues Get new values from measured objects and counts of drawn, culled and occluded
+ * meshes.
  */
 void ProfileWidget::getNewValues()
 {
+    if(ogl != NULL)
+    {
+        const RenderCore* core = ogl->getRenderCore();
+        ui->cullingNumLabel->setText(QString("%1 / %2").arg(core->getDrawnCount()).arg(core->getCulledCount()));
+        ui->occlusionNumLabel->setText(QString("%1").arg(core->getOccludedCount()));
+
+        if(core->isDrawTiming())
+            refreshDraws();
+    }
+
     if(timeList.isEmpty())
         return;
 
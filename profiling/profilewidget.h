@@ -21,6 +21,10 @@ public:
 
     void setGLWindow(OGLwindow* window);
 
+protected:
+    virtual void showEvent(QShowEvent *event);
+    virtual void hideEvent(QHideEvent *event);
+
 public slots:
     void addValue(double time);
     void insertShProgram(QString name);
@@ -32,6 +36,8 @@ public slots:
 private slots:
     void getNewValues();
     void setShaderProgram(QString name);
+    void updateDrawTiming();
+    void refreshDraws();
     
 private:
     Ui::ProfileWidget *ui;
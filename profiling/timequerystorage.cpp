@@ -1,15 +1,22 @@
 #include "timequerystorage.h"
 
 /**
- * @brief TimeQueryStorage::TimeQueryStorage Create new query object. Set canUse flag to true and zore measured times.
+ * @brief TimeQueryStorage::TimeQueryStorage Create empty ring of queries and zero measured time.
  * @param progName Shader program name what this object measuring.
  */
 TimeQueryStorage::TimeQueryStorage(QString progName) :
     progName(progName),
-    canUse(true)
+    canUse(false)
 {
-    time = 0;
     finalTime = 0;
+    current = 0;
+    droppedFrames = 0;
+
+    for(int i = 0; i < ringSize; ++i)
+    {
+        frames[i].used = 0;
+        frames[i].pending = false;
+    }
 }
 
 /**
@@ -22,92 +29,140 @@ QString TimeQueryStorage::getName() const
 }
 
 /**
- * @brief TimeQueryStorage::pushQuery Save new query to back of list.
- * @param queryId Id of created OpenGL query.
+ * @brief TimeQueryStorage::beginFrame Move to next slot of ring. Slot can be used only when results
+ * of its previous frame were read, otherwise frame is not measured.
+ * @return True if frame can be measured, false otherwise.
  */
-void TimeQueryStorage::pushQuery(const uint queryId)
+bool TimeQueryStorage::beginFrame()
 {
-    query.push_back(queryId);
+    current = (current + 1) % ringSize;
+    canUse = !frames[current].pending;
+
+    if(canUse)
+        frames[current].used = 0;
+    else
+        ++droppedFrames;
+
+    return canUse;
 }
 
 /**
- * @brief TimeQueryStorage::topQuery Return oldest OpenGL query id.
- * @return Return OpenGL query id.
+ * @brief TimeQueryStorage::endFrame Mark queries of actual frame as waiting for results.
  */
-uint TimeQueryStorage::topQuery() const
+void TimeQueryStorage::endFrame()
 {
-    return query.front();
+    if(canUse && frames[current].used > 0)
+        frames[current].pending = true;
+
+    canUse = false;
 }
 
 /**
- * @brief TimeQueryStorage::popQuery Return oldest OpenGL query id and remove it.
- * @return Return OpenGL query id.
+ * @brief TimeQueryStorage::isUsable Test if queries can be issued in actual frame.
+ * @return True if actual frame is measured, false otherwise.
  */
-uint TimeQueryStorage::popQuery()
+bool TimeQueryStorage::isUsable() const
 {
-    uint ret = query.front();
-    query.removeFirst();
-    return ret;
+    return canUse;
 }
 
 /**
- * @brief TimeQueryStorage::getQuerySize Get number of saved queries.
- * @return Number of saved queries.
+ * @brief TimeQueryStorage::needsQuery Test if all queries of actual slot are used and new one must be added.
+ * @return True if new query must be added, false otherwise.
  */
-int TimeQueryStorage::getQuerySize() const
+bool TimeQueryStorage::needsQuery() const
 {
-    return query.size();
+    return frames[current].used == frames[current].queries.size();
 }
 
 /**
- * @brief TimeQueryStorage::setTime Set new measured time (not final time, it can be only part of final time).
- * @param time Measured time.
+ * @brief TimeQueryStorage::addQuery Add new query to actual slot of ring. Query is kept until object is deleted.
+ * @param queryId Id of created OpenGL query.
  */
-void TimeQueryStorage::setTime(double time)
+void TimeQueryStorage::addQuery(const uint queryId)
 {
-    this->time = time;
+    frames[current].queries.append(queryId);
 }
 
 /**
- * @brief TimeQueryStorage::getTime Return measured time (not final time, can be only part of final value).
- * @return Measured time.
+ * @brief TimeQueryStorage::nextQuery Return next unused query of actual frame and mark it as used.
+ * @return OpenGL query id.
  */
-double TimeQueryStorage::getTime() const
+uint TimeQueryStorage::nextQuery()
 {
-    return time;
+    Frame& frame = frames[current];
+
+    return frame.queries.at(frame.used++);
 }
 
 /**
- * @brief TimeQueryStorage::getFinalTime Return final time of last drawing with this shader program.
- * @return Final time of last drawing.
+ * @brief TimeQueryStorage::getOldestPending Get the oldest slot which waits for results.
+ * @return Index of slot, -1 if no slot waits.
  */
-double TimeQueryStorage::getFinalTime() const
+int TimeQueryStorage::getOldestPending() const
 {
-    return finalTime;
+    for(int i = 1; i <= ringSize; ++i)
+    {
+        const int frame = (current + i) % ringSize;
+
+        if(frames[frame].pending)
+            return frame;
+    }
+
+    return -1;
 }
 
 /**
- * @brief TimeQueryStorage::isQueryEmpty Is this query object empty.
- * @return True if no query is saved here, false otherwise.
+ * @brief TimeQueryStorage::getFrameQueries Get queries used in frame of given slot.
+ * @param frame Index of slot.
+ * @return OpenGL query ids in order of issuing.
  */
-bool TimeQueryStorage::isQueryEmpty() const
+QVector<uint> TimeQueryStorage::getFrameQueries(int frame) const
 {
-    return query.isEmpty();
+    return frames[frame].queries.mid(0, frames[frame].used);
 }
 
 /**
- * @brief TimeQueryStorage::testUsage Test if this object can be used for creating new queries.
- * If this object have empty query list then it can be used and setting canUse flag to true, to false otherwise.
+ * @brief TimeQueryStorage::setFrameTime Set measured time of frame and release its slot for next frames.
+ * @param frame Index of slot.
+ * @param time Sum of results of all queries of the frame.
  */
-void TimeQueryStorage::testUsage()
+void TimeQueryStorage::setFrameTime(int frame, double time)
 {
-    canUse = isQueryEmpty();
+    finalTime = time;
+    frames[frame].pending = false;
+}
 
-    // we get all values from last draw
-    // save time to final
-    if(canUse)
-    {
-        finalTime = time;
-        time = 0;
-    }
+/**
+ * @brief TimeQueryStorage::getAllQueries Get all queries of all slots, for deleting of OpenGL objects.
+ * @return OpenGL query ids.
+ */
+QVector<uint> TimeQueryStorage::getAllQueries() const
+{
+    QVector<uint> ret;
+
+    for(int i = 0; i < ringSize; ++i)
+        ret += frames[i].queries;
+
+    return ret;
+}
+
+/**
+ * @brief TimeQueryStorage::getDroppedFrames Get number of frames which were not measured because
+ * all slots of ring waited for results.
+ * @return Number of not measured frames.
+ */
+int TimeQueryStorage::getDroppedFrames() const
+{
+    return droppedFrames;
+}
+
+/**
+ * @brief TimeQueryStorage::getFinalTime Return time of the newest drawing with this shader program,
+ * which has available results.
+ * @return Final time of last drawing.
+ */
+double TimeQueryStorage::getFinalTime() const
+{
+    return finalTime;
 }
@@ -2,44 +2,55 @@
 #define TIMEQUERYSTORAGE_H
 
 #include <QString>
-#include <QList>
-#include <QStack>
+#include <QVector>
 
+/**
+ * @brief The TimeQueryStorage class Ring of OpenGL time queries of one shader program. Every frame has its own slot
+ * with queries, queries are created only when slot needs more of them and they are reused in later frames.
+ * Results are read few frames later, so reading never waits for GPU.
+ */
 class TimeQueryStorage
 {
 public:
+    const static int ringSize = 4;
+
     TimeQueryStorage(QString progName);
 
     QString getName() const;
 
-    void pushQuery(const uint queryId);
-    uint topQuery() const;
-    uint popQuery();
+    bool beginFrame();
+    void endFrame();
 
-    int getQuerySize() const;
+    bool isUsable() const;
+    bool needsQuery() const;
+    void addQuery(const uint queryId);
+    uint nextQuery();
 
-    void setTime(double time);
-    double getTime() const;
+    int getOldestPending() const;
+    QVector<uint> getFrameQueries(int frame) const;
+    void setFrameTime(int frame, double time);
 
-    //void setFinalTime(double time);
-    double getFinalTime() const;
+    QVector<uint> getAllQueries() const;
+    int getDroppedFrames() const;
 
-    bool isQueryEmpty() const;
+    double getFinalTime() const;
 
-    void testUsage();
+private:
     /**
-     * @brief isUsable If this flag is set to true this object can be used for another measuring,
-     * if not you will get bad values with old and new measures in one value.
-     * @return Return true if can be used, false otherwise.
+     * @brief The Frame struct Queries of one frame, used queries are at the beginning.
      */
-    inline bool isUsable() const {return this->canUse;}
+    struct Frame {
+        QVector<uint> queries;
+        int used;
+        bool pending;
+    };
 
-private:
     const QString progName;
-    double time;
     double finalTime;
-    QList<uint> query;
+    Frame frames[ringSize];
+    int current;
     bool canUse;
+    int droppedFrames;
 };
 
 #endif // TIMEQUERYSTORAGE_H
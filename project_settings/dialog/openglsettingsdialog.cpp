@@ -19,6 +19,7 @@ OpenglSettingsDialog::OpenglSettingsDialog(QWidget *parent) :
 
     initClearSpinBoxes();
     initComboBoxes();
+    initReplicationSpinBoxes();
     setDefaultValues();
 
     ui->blendWidget->setVisible(false);
@@ -50,6 +51,10 @@ void OpenglSettingsDialog::accept()
 
     settings->setDepthTest(ui->depthTestBox->isChecked());
 
+    settings->setReplication(ui->replicationColumnsSpin->value(), ui->replicationRowsSpin->value());
+
+    settings->setLodGeneration(ui->lodGenerationBox->isChecked());
+
     // blending
     bool isBlend = ui->blendingCheck->isChecked();
 
@@ -130,6 +135,18 @@ void OpenglSettingsDialog::initComboBoxes()
     ui->blendSFactorBox->setCurrentIndex(0);
 }
 
+/**
+ * @brief OpenglSettingsDialog::initReplicationSpinBoxes Initialize spin boxes for size of model replication grid.
+ */
+void OpenglSettingsDialog::initReplicationSpinBoxes()
+{
+    ui->replicationColumnsSpin->setMinimum(1);
+    ui->replicationColumnsSpin->setMaximum(100);
+
+    ui->replicationRowsSpin->setMinimum(1);
+    ui->replicationRowsSpin->setMaximum(100);
+}
+
 /**
  * @brief OpenglSettingsDialog::setDefaultValues Set default values from active project.
  */
@@ -163,6 +180,13 @@ void OpenglSettingsDialog::setDefaultValues()
 
     // set depth test
     ui->depthTestBox->setChecked(settings->isDepthTest());
+
+    // set replication
+    ui->replicationColumnsSpin->setValue(settings->getReplicationColumns());
+    ui->replicationRowsSpin->setValue(settings->getReplicationRows());
+
+    // set generation of levels of detail
+    ui->lodGenerationBox->setChecked(settings->isLodGeneration());
 }
 
 /**
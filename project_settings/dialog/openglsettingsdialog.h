@@ -25,6 +25,7 @@ public:
 private:
     void initClearSpinBoxes();
     void initComboBoxes();
+    void initReplicationSpinBoxes();
     void setDefaultValues();
 
 private slots:
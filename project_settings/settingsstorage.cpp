@@ -19,6 +19,11 @@ SettingsStorage::SettingsStorage(QObject *parent) :
     backgroundColor[3] = 1.0;
 
     depthTest = true;
+
+    replicationColumns = 1;
+    replicationRows = 1;
+
+    lodGeneration = false;
 }
 
 /**
@@ -120,6 +125,55 @@ bool SettingsStorage::isDepthTest() const
     return this->depthTest;
 }
 
+/**
+ * @brief SettingsStorage::setReplication Set how many times will be model drawn in grid, for load testing of shaders.
+ * Copies with the same mesh and shader program are drawn with instancing when shader program supports it.
+ * @param columns Number of copies along x axis, at least 1.
+ * @param rows Number of copies along z axis, at least 1.
+ */
+void SettingsStorage::setReplication(int columns, int rows)
+{
+    this->replicationColumns = qMax(columns, 1);
+    this->replicationRows = qMax(rows, 1);
+}
+
+/**
+ * @brief SettingsStorage::getReplicationColumns Get number of model copies along x axis.
+ * @return Number of columns of replication grid.
+ */
+int SettingsStorage::getReplicationColumns() const
+{
+    return this->replicationColumns;
+}
+
+/**
+ * @brief SettingsStorage::getReplicationRows Get number of model copies along z axis.
+ * @return Number of rows of replication grid.
+ */
+int SettingsStorage::getReplicationRows() const
+{
+    return this->replicationRows;
+}
+
+/**
+ * @brief SettingsStorage::setLodGeneration Set if simplified levels of detail are generated for meshes
+ * of the model when it is loaded.
+ * @param generate True for generation of levels of detail.
+ */
+void SettingsStorage::setLodGeneration(bool generate)
+{
+    this->lodGeneration = generate;
+}
+
+/**
+ * @brief SettingsStorage::isLodGeneration Test if levels of detail are generated when model is loaded.
+ * @return True if levels of detail are generated, false otherwise.
+ */
+bool SettingsStorage::isLodGeneration() const
+{
+    return this->lodGeneration;
+}
+
 /**
  * @brief operator << Operator for serialization of this class.
  * @param stream Where to serialize this.
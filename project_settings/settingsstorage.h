@@ -34,6 +34,14 @@ public:
     void setDepthTest(bool isDepth);
     bool isDepthTest() const;
 
+    // replication of the model for load tests
+    void setReplication(int columns, int rows);
+    int getReplicationColumns() const;
+    int getReplicationRows() const;
+
+    // simplified levels of detail of loaded model
+    void setLodGeneration(bool generate);
+    bool isLodGeneration() const;
 
     friend QDataStream & operator<< (QDataStream& stream, const SettingsStorage* settings);
     friend QDataStream & operator>> (QDataStream& stream, SettingsStorage*& settings);
@@ -45,6 +53,9 @@ private:
     bool blending;
     float backgroundColor[4];
     bool depthTest;
+    int replicationColumns;
+    int replicationRows;
+    bool lodGeneration;
     
 signals:
     
@@ -0,0 +1,234 @@
+#include "offscreenrenderer.h"
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QOpenGLFramebufferObject>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+
+// how long we wait for shader programs and textures in milliseconds
+#define OFFSCREEN_LOAD_TIMEOUT 30000
+
+/**
+ * @brief OffscreenRenderer::OffscreenRenderer Create offscreen renderer, surface and context are created by create method.
+ * @param parent Parent of this object.
+ */
+OffscreenRenderer::OffscreenRenderer(QObject *parent) :
+    QObject(parent),
+    surface(NULL),
+    context(NULL),
+    fbo(NULL),
+    core(NULL)
+{
+}
+
+/**
+ * @brief OffscreenRenderer::~OffscreenRenderer Delete render core, framebuffer, context and surface.
+ */
+OffscreenRenderer::~OffscreenRenderer()
+{
+    destroy();
+}
+
+/**
+ * @brief OffscreenRenderer::create Create offscreen surface and OpenGL 3.3 core profile context.
+ * @param size Size of rendered images.
+ * @return True if surface, context and framebuffer are created, false otherwise.
+ */
+bool OffscreenRenderer::create(const QSize &size)
+{
+    QSurfaceFormat format;
+    format.setVersion(3, 3); // OpenGL core version
+    format.setProfile(QSurfaceFormat::CoreProfile);
+    format.setDepthBufferSize(24);
+
+    return create(size, format);
+}
+
+/**
+ * @brief OffscreenRenderer::create Create offscreen surface, OpenGL context with given format, framebuffer object
+ * and render core which draws to this framebuffer.
+ * @param size Size of rendered images.
+ * @param format Format of OpenGL context.
+ * @return True if surface, context and framebuffer are created, false otherwise.
+ */
+bool OffscreenRenderer::create(const QSize &size, const QSurfaceFormat &format)
+{
+    destroy();
+
+    if(size.isEmpty())
+        return false;
+
+    surface = new QOffscreenSurface();
+    surface->setFormat(format);
+    surface->create();
+
+    if(!surface->isValid())
+    {
+        qWarning() << "Could not create offscreen surface";
+        destroy();
+        return false;
+    }
+
+    context = new QOpenGLContext();
+    context->setFormat(format);
+
+    if(!context->create() || !context->makeCurrent(surface))
+    {
+        qWarning() << "Could not create OpenGL context for offscreen rendering";
+        destroy();
+        return false;
+    }
+
+    fbo = new QOpenGLFramebufferObject(size, QOpenGLFramebufferObject::Depth);
+
+    if(!fbo->isValid())
+    {
+        qWarning() << "Could not create framebuffer object for offscreen rendering";
+        destroy();
+        return false;
+    }
+
+    this->size = size;
+
+    core = new RenderCore(NULL, this);
+
+    if(!core->initialize())
+    {
+        destroy();
+        return false;
+    }
+
+    fbo->bind();
+    core->resize(size.width(), size.height());
+
+    return true;
+}
+
+/**
+ * @brief OffscreenRenderer::destroy Delete render core and all OpenGL objects.
+ */
+void OffscreenRenderer::destroy()
+{
+    if(context != NULL && surface != NULL)
+        context->makeCurrent(surface);
+
+    delete core;
+    core = NULL;
+
+    delete fbo;
+    fbo = NULL;
+
+    if(context != NULL)
+        context->doneCurrent();
+
+    delete context;
+    context = NULL;
+
+    delete surface;
+    surface = NULL;
+
+    size = QSize();
+}
+
+/**
+ * @brief OffscreenRenderer::isCreated Test if renderer is ready for rendering.
+ * @return True if renderer is created, false otherwise.
+ */
+bool OffscreenRenderer::isCreated() const
+{
+    return core != NULL;
+}
+
+/**
+ * @brief OffscreenRenderer::makeCurrent Make OpenGL context of this renderer current and bind its framebuffer.
+ * Must be called before render core is changed outside of renderFrame.
+ * @return True if context is current, false otherwise.
+ */
+bool OffscreenRenderer::makeCurrent()
+{
+    if(!isCreated() || !context->makeCurrent(surface))
+        return false;
+
+    return fbo->bind();
+}
+
+/**
+ * @brief OffscreenRenderer::doneCurrent Release OpenGL context of this renderer.
+ */
+void OffscreenRenderer::doneCurrent()
+{
+    if(context != NULL)
+        context->doneCurrent();
+}
+
+/**
+ * @brief OffscreenRenderer::getRenderCore Get render core, its slots are used for loading of the active project.
+ * @return Render core of this renderer, NULL if renderer is not created.
+ */
+RenderCore *OffscreenRenderer::getRenderCore()
+{
+    return core;
+}
+
+/**
+ * @brief OffscreenRenderer::getSize Get size of rendered images.
+ * @return Size of framebuffer.
+ */
+QSize OffscreenRenderer::getSize() const
+{
+    return size;
+}
+
+/**
+ * @brief OffscreenRenderer::setView Set view matrix of the camera.
+ * @param view View matrix.
+ */
+void OffscreenRenderer::setView(const QMatrix4x4 &view)
+{
+    if(isCreated())
+        core->setView(view);
+}
+
+/**
+ * @brief OffscreenRenderer::renderFrame Draw one frame of the active project to framebuffer and read it back.
+ * Events are processed while shader programs and textures are loaded.
+ * @return Rendered image, null image if renderer is not created or loading timed out.
+ */
+QImage OffscreenRenderer::renderFrame()
+{
+    if(!makeCurrent())
+        return QImage();
+
+    core->render();
+
+    // shader programs and images are loaded in other threads, frame is drawn again until they are ready,
+    // results of threads are delivered by events
+    QElapsedTimer timer;
+    timer.start();
+
+    while(core->isCompiling() || core->isLoadingTextures())
+    {
+        if(timer.elapsed() > OFFSCREEN_LOAD_TIMEOUT)
+        {
+            qWarning() << "Shader programs or textures were not loaded in time for offscreen rendering";
+            doneCurrent();
+            return QImage();
+        }
+
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+
+        // events can change current context
+        if(!makeCurrent())
+            return QImage();
+
+        core->render();
+    }
+
+    glFinish();
+
+    QImage image = fbo->toImage();
+
+    doneCurrent();
+
+    return image;
+}
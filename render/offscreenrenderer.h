@@ -0,0 +1,48 @@
+#ifndef OFFSCREENRENDERER_H
+#define OFFSCREENRENDERER_H
+
+#include "rendercore.h"
+#include <QObject>
+#include <QSize>
+#include <QImage>
+#include <QSurfaceFormat>
+
+class QOffscreenSurface;
+class QOpenGLContext;
+class QOpenGLFramebufferObject;
+
+/**
+ * @brief The OffscreenRenderer class Render active project without window. Owns offscreen surface, OpenGL context
+ * and framebuffer object, where render core draws. Can be used on machines without display with software OpenGL,
+ * for example with offscreen platform plugin (QT_QPA_PLATFORM=offscreen).
+ */
+class OffscreenRenderer : public QObject
+{
+    Q_OBJECT
+public:
+    explicit OffscreenRenderer(QObject *parent = 0);
+    ~OffscreenRenderer();
+
+    bool create(const QSize &size);
+    bool create(const QSize &size, const QSurfaceFormat &format);
+    void destroy();
+    bool isCreated() const;
+
+    bool makeCurrent();
+    void doneCurrent();
+
+    RenderCore* getRenderCore();
+    QSize getSize() const;
+    void setView(const QMatrix4x4 &view);
+
+    QImage renderFrame();
+
+private:
+    QOffscreenSurface* surface;
+    QOpenGLContext* context;
+    QOpenGLFramebufferObject* fbo;
+    RenderCore* core;
+    QSize size;
+};
+
+#endif // OFFSCREENRENDERER_H
@@ -0,0 +1,7 @@
+#Render core and its offscreen target
+
+HEADERS +=  render/rendercore.h \
+    render/offscreenrenderer.h
+
+SOURCES +=  render/rendercore.cpp \
+    render/offscreenrenderer.cpp
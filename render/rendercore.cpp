@@ -0,0 +1,3918 @@
+#include "rendercore.h"
+#include "meta_data/metashaderprog.h"
+#include "model_work/storage/mesh.h"
+#include "model_work/storage/model.h"
+#include <QFile>
+#include <QDir>
+#include <QCryptographicHash>
+#include <algorithm>
+
+#define MVP_CHAR "mvp"
+#define PROJECTION_CHAR "projectionM"
+#define VIEW_CHAR "viewM"
+#define MODEL_CHAR "modelM"
+#define INSTANCE_MODEL_CHAR "instanceModelM"
+
+#define FRAME_BLOCK_CHAR "ShaderManFrame"
+#define OBJECT_BLOCK_CHAR "ShaderManObject"
+#define SHARED_BLOCK_CHAR "ShaderManShared"
+
+#define PROGRAM_CACHE_DIR "program_cache"
+#define TEXTURE_CACHE_DIR "texture_cache"
+
+// part of screen height covered by mesh which is drawn with full detail
+#define LOD_SCREEN_SIZE 0.25f
+
+// tested boxes are enlarged by this distance, boxes around camera are not tested, near plane would clip them
+#define OCCLUSION_BOX_MARGIN 0.2f
+
+// program for bounding boxes of occlusion queries
+#define OCCLUSION_VERTEX_SHADER "#version 330\n" \
+                                "layout(location = 0) in vec3 position;\n" \
+                                "uniform mat4 mvp;\n" \
+                                "void main()\n" \
+                                "{\n" \
+                                "    gl_Position = mvp * vec4(position, 1.0);\n" \
+                                "}\n"
+#define OCCLUSION_FRAGMENT_SHADER "#version 330\n" \
+                                  "out vec4 color;\n" \
+                                  "void main()\n" \
+                                  "{\n" \
+                                  "    color = vec4(1.0);\n" \
+                                  "}\n"
+
+// the same value is used by GL_KHR_parallel_shader_compile and GL_ARB_parallel_shader_compile
+#define COMPLETION_STATUS 0x91B1
+
+#define FRAME_BLOCK_BINDING 0
+#define OBJECT_BLOCK_BINDING 1
+#define SHARED_BLOCK_BINDING 2
+
+/**
+ * @brief RenderCore::RenderCore Create render core. OpenGL objects are created later in context which is current
+ * when initialize is called.
+ * @param edit Logging widget in program, can be NULL when rendering without window.
+ * @param parent Parent of this object.
+ */
+RenderCore::RenderCore(QTextEdit *edit, QObject *parent) :
+    QObject(parent),
+    occlusionBoxBuffer(QGLBuffer::VertexBuffer),
+    modelVertexBuffer(QGLBuffer::VertexBuffer),
+    modelIndexBuffer(QGLBuffer::IndexBuffer),
+    instanceBuffer(QGLBuffer::VertexBuffer),
+    frameBlock(FRAME_BLOCK_CHAR, FRAME_BLOCK_BINDING),
+    objectBlock(OBJECT_BLOCK_CHAR, OBJECT_BLOCK_BINDING),
+    sharedBlock(SHARED_BLOCK_CHAR, SHARED_BLOCK_BINDING)
+{
+    testingVar = true;
+
+    for(int i = 0; i < 15; ++i)
+        buttonPressedField[i] = false;
+
+    isDrawPaused = false;
+
+    rootNode = NULL;
+    isDrawListSorted = false;
+    drawnCount = 0;
+    culledCount = 0;
+    lodOverride = -1;
+    occlusionCulling = false;
+    occludedCount = 0;
+    occlusionProgram = NULL;
+    occlusionArray = 0;
+    occlusionTarget = GL_ANY_SAMPLES_PASSED;
+    drawTiming = false;
+    objectStride = OBJECT_BLOCK_SIZE;
+
+    viewportWidth = 1;
+    viewportHeight = 1;
+
+    projection.perspective(60,4.0/3.0,0.1,500.0);
+    //projection.ortho(-20,20,-20,20,0.1,500);
+    view.translate(0.0,0.0,-4.0);
+
+    mvpStack.push(projection);
+    //mvpStack.push(projection*view);
+
+    QMatrix4x4 mat;
+    mat.setToIdentity();
+    mvpStack.push(mvpStack.top() * mat);
+
+    if(edit != NULL)
+        log.setLogWindow(edit);
+
+    canRender = false;
+    showErrors = true;
+    dirtyFlags = DIRTY_ALL;
+    updatePending = false;
+    parallelCompile = false;
+    restartCompile = false;
+    uniformsReset = false;
+
+    infoM = InfoManager::getInstance();
+}
+
+/**
+ * @brief RenderCore::~RenderCore Clean memory, OpenGL context used for rendering must be current.
+ */
+RenderCore::~RenderCore()
+{
+    removePendingPrograms();
+    removeReusablePrograms();
+    removeShaderObjects(false);
+    qDeleteAll(shaders);
+    qDeleteAll(programs);
+    qDeleteAll(textureCache);
+
+    removeQueries();
+    qDeleteAll(profiles);
+    qDeleteAll(uniformTimers);
+}
+
+/**
+ * @brief RenderCore::submitShaders Start compiling of shaders from shader program. Linked binary is restored from
+ * program cache when it exists, otherwise shader objects are submitted to driver and their status is tested
+ * after all shader programs are linked.
+ * @param prog Shader program from where we get shaders.
+ * @return Return true if shader sources are read and submitted, otherwise false.
+ */
+bool RenderCore::submitShaders(const MetaShaderProg* prog)
+{
+    MetaProject* actProj = infoM->getActiveProject();
+
+    if(!prog->isValid())
+    {
+        log.addToLog(tr("Shader program %1 canno't be used. No valid vertex and fragment shader are set.")
+                     .arg(prog->getName()));
+        return false;
+    }
+
+    bool shaderMissing = false;
+    QByteArray vertexSource;
+    QByteArray fragmentSource;
+
+    //read vertex shader
+    MetaShader* vertex = actProj->getVertexShader(prog->getVertexShader());
+    if(vertex == NULL)
+    {
+        log.addVertexLog(tr("Vertex shader '%1' from shader program '%2' missing!")
+                         .arg(prog->getVertexShader(), prog->getName()));
+        shaderMissing = true;
+    }
+    else if(!readShaderSource(actProj->getVertexFilePath(vertex->getShader()), vertexSource))
+    {
+        log.addVertexLog(tr("Vertex shader file '%1' canno't be read!")
+                         .arg(actProj->getVertexFilePath(vertex->getShader())));
+        shaderMissing = true;
+    }
+
+    //read fragment shader
+    MetaShader* fragment = actProj->getFragmentShader(prog->getFragmentShader());
+    if(fragment == NULL)
+    {
+        log.addFragmentLog(tr("Fragment shader '%1' from shader program '%2' missing!")
+                           .arg(prog->getFragmentShader(), prog->getName()));
+        shaderMissing = true;
+    }
+    else if(!readShaderSource(actProj->getFragmentFilePath(fragment->getShader()), fragmentSource))
+    {
+        log.addFragmentLog(tr("Fragment shader file '%1' canno't be read!")
+                           .arg(actProj->getFragmentFilePath(fragment->getShader())));
+        shaderMissing = true;
+    }
+
+    if(shaderMissing)
+        return false;
+
+    PendingProgram pending;
+    pending.name = prog->getName();
+    pending.vertexShader = 0;
+    pending.fragmentShader = 0;
+    pending.cacheKey = programCache.createKey(vertexSource, fragmentSource);
+
+    // shader program linked before with the same sources is used again
+    if(reusableShaders.contains(pending.name) && programKeys.value(pending.name) == pending.cacheKey)
+    {
+        pending.program = reusableShaders.take(pending.name);
+        pending.isCached = true;
+        pendingPrograms.append(pending);
+
+        return true;
+    }
+
+    // linked binary from previous run is used when sources and driver are the same
+    pending.program = new QGLShaderProgram(this);
+    pending.isCached = programCache.loadProgram(pending.program->programId(), pending.cacheKey) &&
+            pending.program->link();
+
+    if(!pending.isCached)
+    {
+        // program object can contain rejected binary, new one is used for compiling from sources
+        delete pending.program;
+        pending.program = new QGLShaderProgram(this);
+
+        pending.vertexShader = getShaderObject(GL_VERTEX_SHADER, actProj->getVertexFilePath(vertex->getShader()),
+                                               vertexSource);
+        pending.fragmentShader = getShaderObject(GL_FRAGMENT_SHADER,
+                                                 actProj->getFragmentFilePath(fragment->getShader()), fragmentSource);
+    }
+
+    pendingPrograms.append(pending);
+
+    return true;
+}
+
+/**
+ * @brief RenderCore::getShaderObject Get shader object compiled from file. Shader objects are shared by all
+ * shader programs using the same file and compiled again only when source of the file changed.
+ * @param type Type of shader (GL_VERTEX_SHADER or GL_FRAGMENT_SHADER).
+ * @param path Path to shader file.
+ * @param source Source code of shader.
+ * @return Identifier of shader object.
+ */
+GLuint RenderCore::getShaderObject(GLenum type, const QString path, const QByteArray &source)
+{
+    QString key = QString::number(type) + ':' + path;
+    QByteArray hash = QCryptographicHash::hash(source, QCryptographicHash::Sha1);
+
+    usedShaderObjects.insert(key);
+
+    if(shaderObjects.contains(key))
+    {
+        const ShaderObject& object = shaderObjects[key];
+
+        if(object.hash == hash)
+            return object.shader;
+
+        // shader programs which still use old shader object keep it until they are deleted
+        glDeleteShader(object.shader);
+    }
+
+    ShaderObject object;
+    object.shader = compileShader(type, source);
+    object.hash = hash;
+
+    shaderObjects.insert(key, object);
+
+    return object.shader;
+}
+
+/**
+ * @brief RenderCore::removeShaderObjects Delete shader objects.
+ * @param unusedOnly If true delete only shader objects which were not used by last compiling.
+ */
+void RenderCore::removeShaderObjects(bool unusedOnly)
+{
+    QMutableHashIterator<QString,ShaderObject> it(shaderObjects);
+
+    while(it.hasNext())
+    {
+        it.next();
+
+        if(unusedOnly && usedShaderObjects.contains(it.key()))
+            continue;
+
+        glDeleteShader(it.value().shader);
+        it.remove();
+    }
+
+    usedShaderObjects.clear();
+}
+
+/**
+ * @brief RenderCore::keepLinkedPrograms Move linked shader programs aside before shader programs are created again.
+ * Shader programs with unchanged sources are used again without compiling.
+ */
+void RenderCore::keepLinkedPrograms()
+{
+    QHashIterator<QString,QGLShaderProgram*> it(shaders);
+
+    while(it.hasNext())
+    {
+        it.next();
+
+        delete reusableShaders.value(it.key());
+        reusableShaders.insert(it.key(), it.value());
+    }
+
+    shaders.clear();
+}
+
+/**
+ * @brief RenderCore::removeReusablePrograms Delete linked shader programs which were not used again.
+ */
+void RenderCore::removeReusablePrograms()
+{
+    qDeleteAll(reusableShaders);
+    reusableShaders.clear();
+}
+
+/**
+ * @brief RenderCore::compileShader Create shader object and start its compiling. Compile status is not tested here,
+ * so driver can compile more shaders at once.
+ * @param type Type of shader (GL_VERTEX_SHADER or GL_FRAGMENT_SHADER).
+ * @param source Source code of shader.
+ * @return Identifier of shader object.
+ */
+GLuint RenderCore::compileShader(GLenum type, const QByteArray &source)
+{
+    GLuint shader = glCreateShader(type);
+
+    const GLchar* data = source.constData();
+    GLint length = source.size();
+
+    glShaderSource(shader, 1, &data, &length);
+    glCompileShader(shader);
+
+    return shader;
+}
+
+/**
+ * @brief RenderCore::linkShaders Attach shader objects to shader program and start its linking.
+ * @param pending Shader program waiting for compiling.
+ */
+void RenderCore::linkShaders(const PendingProgram &pending)
+{
+    if(pending.isCached)
+        return;
+
+    GLuint programId = pending.program->programId();
+
+    programCache.prepareProgram(programId);
+
+    glAttachShader(programId, pending.vertexShader);
+    glAttachShader(programId, pending.fragmentShader);
+    glLinkProgram(programId);
+}
+
+/**
+ * @brief RenderCore::isShaderCompiled Test compile status of shader object.
+ * @param shader Identifier of shader object.
+ * @return True if shader was compiled without errors, false otherwise.
+ */
+bool RenderCore::isShaderCompiled(GLuint shader) const
+{
+    GLint status = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+
+    return status == GL_TRUE;
+}
+
+/**
+ * @brief RenderCore::getShaderLog Get compile log of shader object.
+ * @param shader Identifier of shader object.
+ * @return Compile log.
+ */
+QString RenderCore::getShaderLog(GLuint shader) const
+{
+    GLint length = 0;
+    glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+
+    if(length <= 1)
+        return QString();
+
+    QByteArray shaderLog(length, 0);
+    glGetShaderInfoLog(shader, length, NULL, shaderLog.data());
+
+    return QString::fromLatin1(shaderLog.constData());
+}
+
+/**
+ * @brief RenderCore::finishShaders Test compile and link status of shader program and log errors. Linked shader
+ * program is stored to program cache and used for drawing.
+ * @param pending Shader program waiting for compiling.
+ * @return True if shader program is linked, false otherwise.
+ */
+bool RenderCore::finishShaders(PendingProgram &pending)
+{
+    bool isFailed = false;
+
+    if(!pending.isCached)
+    {
+        if(!isShaderCompiled(pending.vertexShader))
+        {
+            log.addVertexLog(getShaderLog(pending.vertexShader));
+            isFailed = true;
+        }
+
+        if(!isShaderCompiled(pending.fragmentShader))
+        {
+            log.addFragmentLog(getShaderLog(pending.fragmentShader));
+            isFailed = true;
+        }
+
+        // shader program is already linked, QGLShaderProgram only reads link status
+        if(!pending.program->link())
+        {
+            log.addLinkLog(pending.program->log());
+            isFailed = true;
+        }
+        else if(!isFailed)
+        {
+            programCache.saveProgram(pending.program->programId(), pending.cacheKey);
+        }
+    }
+
+    if(isFailed)
+        return false;
+
+    if(shaders.contains(pending.name))
+    {
+        delete shaders.value(pending.name);
+    }
+
+    shaders.insert(pending.name, pending.program);
+    programKeys.insert(pending.name, pending.cacheKey);
+    pending.program = NULL;
+
+    return true;
+}
+
+/**
+ * @brief RenderCore::readShaderSource Read source code of shader from file.
+ * @param path Path to shader file.
+ * @param source Read source code.
+ * @return True if file was read, false otherwise.
+ */
+bool RenderCore::readShaderSource(const QString path, QByteArray &source)
+{
+    QFile file(path);
+
+    if(!file.open(QIODevice::ReadOnly))
+        return false;
+
+    source = file.readAll();
+    file.close();
+
+    return true;
+}
+
+/**
+ * @brief RenderCore::getTimeQuery Get time query object reference. For measuring drawing time.
+ * @param progName Shader program name, what we want to measure.
+ * @return Return time query measure object.
+ */
+const TimeQueryStorage *RenderCore::getTimeQuery(const QString progName)
+{
+    return profiles.value(progName,NULL);
+}
+
+/**
+ * @brief RenderCore::getTimeQueries Get all time query measure objects. For measuring drawing time of all shader programs.
+ * @return Return list of time query measure objects.
+ */
+QList<const TimeQueryStorage *> RenderCore::getTimeQueries()
+{
+    QList<const TimeQueryStorage *> ret;
+
+    foreach(TimeQueryStorage* s, profiles)
+    {
+        ret.append(s);
+    }
+
+    return ret;
+}
+
+/**
+ * @brief RenderCore::getDrawnCount Get number of meshes which passed frustum culling in last drawing.
+ * Every instance of instanced draw is counted.
+ * @return Number of drawn meshes.
+ */
+int RenderCore::getDrawnCount() const
+{
+    return drawnCount;
+}
+
+/**
+ * @brief RenderCore::getCulledCount Get number of meshes which were outside of view frustum in last drawing.
+ * Every instance of instanced draw is counted.
+ * @return Number of culled meshes.
+ */
+int RenderCore::getCulledCount() const
+{
+    return culledCount;
+}
+
+/**
+ * @brief RenderCore::setLodOverride Draw all meshes with given level of detail instead of level selected
+ * by size of mesh on screen. Meshes with less levels are drawn with their last level.
+ * @param level Level of detail, -1 for automatic selection.
+ */
+void RenderCore::setLodOverride(int level)
+{
+    if(lodOverride == level)
+        return;
+
+    lodOverride = level;
+    isDrawListSorted = false;
+
+    requestUpdate();
+}
+
+/**
+ * @brief RenderCore::getLodOverride Get level of detail used for all meshes.
+ * @return Level of detail, -1 if level is selected automatically.
+ */
+int RenderCore::getLodOverride() const
+{
+    return lodOverride;
+}
+
+/**
+ * @brief RenderCore::setOcclusionCulling Enable or disable occlusion culling. Bounding boxes of drawn meshes are
+ * tested by occlusion queries after the model is drawn and meshes are drawn with conditional rendering by result
+ * of the previous frame, so the processor never waits for results. Hidden mesh which becomes visible can
+ * be missing for one frame.
+ * @param enabled True for occlusion culling.
+ */
+void RenderCore::setOcclusionCulling(bool enabled)
+{
+    if(occlusionCulling == enabled)
+        return;
+
+    occlusionCulling = enabled;
+    occludedCount = 0;
+    occlusionIssued.fill(false);
+
+    requestUpdate();
+}
+
+/**
+ * @brief RenderCore::isOcclusionCulling Test if occlusion culling is enabled.
+ * @return True if occlusion culling is enabled, false otherwise.
+ */
+bool RenderCore::isOcclusionCulling() const
+{
+    return occlusionCulling;
+}
+
+/**
+ * @brief RenderCore::getOccludedCount Get number of meshes skipped by conditional rendering in last drawing.
+ * Every instance of instanced draw is counted.
+ * @return Number of occluded meshes.
+ */
+int RenderCore::getOccludedCount() const
+{
+    return occludedCount;
+}
+
+/**
+ * @brief RenderCore::setDrawTiming Enable or disable recording of GPU timestamps around every draw.
+ * Results are available few frames later by getDrawTimings.
+ * @param enabled True for recording of timestamps.
+ */
+void RenderCore::setDrawTiming(bool enabled)
+{
+    if(drawTiming == enabled)
+        return;
+
+    drawTiming = enabled;
+
+    if(drawTiming)
+        requestUpdate();
+}
+
+/**
+ * @brief RenderCore::isDrawTiming Test if timestamps of draws are recorded.
+ * @return True if timestamps are recorded, false otherwise.
+ */
+bool RenderCore::isDrawTiming() const
+{
+    return drawTiming;
+}
+
+/**
+ * @brief RenderCore::getDrawTimings Get GPU times of draws of the newest measured frame.
+ * @return Draws tagged by node, mesh and shader program in order of drawing.
+ */
+QVector<DrawTimestamps::DrawTiming> RenderCore::getDrawTimings() const
+{
+    return drawTimestamps.getTimings();
+}
+
+/**
+ * @brief RenderCore::getDrawFrameTime Get GPU time from the start of the newest measured frame to the end of its last draw.
+ * @return Time in nanoseconds.
+ */
+qint64 RenderCore::getDrawFrameTime() const
+{
+    return drawTimestamps.getFrameTime();
+}
+
+/**
+ * @brief RenderCore::invalidateRender Invalidate current render. Remove all saved information and set flag to not render.
+ */
+void RenderCore::invalidateRender()
+{
+    canRender = false;
+    releaseResources();
+    removeUniformTimers();
+    dirtyFlags = DIRTY_ALL;
+}
+
+/**
+ * @brief RenderCore::releaseResources Delete all OpenGL objects, they will be created again before next drawing.
+ * Camera, uniform timers and values of special variables are kept. Must be called before OpenGL context
+ * is destroyed, context must be current.
+ */
+void RenderCore::releaseResources()
+{
+    removeSettings();
+    frameBlock.destroy();
+    objectBlock.destroy();
+    dirtyFlags |= DIRTY_ALL & ~DIRTY_UNIFORMS;
+}
+
+/**
+ * @brief RenderCore::setShaderUniform Set shader uniforms to shader program from its binding table. Shader program must be bound.
+ * Uniform variables with the same version as last uploaded one are skipped.
+ * @param table Binding table of the shader program.
+ * @param printWarning If true print errors of multiply variables to log, else do not print.
+ * @return Return true if uniform variables are correctly set to shader, otherwise return false.
+ */
+bool RenderCore::setShaderUniform(ProgramBindings &table, bool printWarning)
+{
+    QGLShaderProgram* glprog = table.program;
+
+    if(glprog == NULL)
+        return false;
+
+    UniformBinding* binding = table.uniforms.data();
+    UniformBinding* end = binding + table.uniforms.size();
+
+    for(; binding != end; ++binding)
+    {
+        const UniformVariable* u = binding->variable;
+        const quint64 version = u->getVersion();
+
+        // values of multiply variables depend on other uniform variables
+        if(binding->version == version && !u->isMultiplyMode())
+            continue;
+
+        attachShaderUniform(*binding, glprog, printWarning);
+        binding->version = version;
+    }
+
+    return true;
+}
+
+/**
+ * @brief RenderCore::createProgramTables Create binding table for every loaded shader program and number them.
+ * Draw list reference shader programs with these numbers.
+ */
+void RenderCore::createProgramTables()
+{
+    programTables.clear();
+    programIds.clear();
+    sharedVersions.clear();
+    sharedBlock.clearLayout();
+
+    QHashIterator<QString,QGLShaderProgram*> it(shaders);
+
+    while(it.hasNext())
+    {
+        it.next();
+
+        ProgramBindings table;
+        table.name = it.key();
+        table.program = it.value();
+        table.mvpLocation = it.value()->uniformLocation(MVP_CHAR);
+        table.modelLocation = it.value()->uniformLocation(MODEL_CHAR);
+        table.instanceLocation = it.value()->attributeLocation(INSTANCE_MODEL_CHAR);
+
+        attachUniformBlocks(table);
+
+        programIds.insert(table.name, programTables.size());
+        programTables.append(table);
+    }
+}
+
+/**
+ * @brief RenderCore::createUniformBindings Find locations of uniform variables attached to all loaded shader programs.
+ * Must be called when shader programs are linked or when uniform variables changed.
+ * @param printWarnings If true print missing variables to log.
+ */
+void RenderCore::createUniformBindings(bool printWarnings)
+{
+    MetaProject* project = infoM->getActiveProject();
+    sharedVariables.clear();
+    sharedVersions.clear();
+
+    for(int i = 0; i < programTables.size(); ++i)
+    {
+        ProgramBindings& table = programTables[i];
+        table.uniforms.clear();
+        table.mvpLocation = table.program->uniformLocation(MVP_CHAR);
+        table.modelLocation = table.program->uniformLocation(MODEL_CHAR);
+
+        QList<UniformVariable*> unif = project->getUniformVariables(table.name);
+
+        foreach(UniformVariable* u, unif)
+        {
+            QStringList variables = u->getAttachedVariables(table.name);
+
+            foreach(QString var, variables)
+            {
+                int loc = table.program->uniformLocation(var);
+
+                // shared variables are packed to uniform block once per frame
+                if(loc < 0 && sharedBlock.hasMember(var))
+                {
+                    UniformVariable* shared = sharedVariables.value(var, u);
+
+                    if(shared != u && printWarnings)
+                        log.addUniformError(tr("Shared uniform variable '%1' is already set by '%2'.")
+                                            .arg(var, shared->getName()));
+
+                    sharedVariables.insert(var, shared);
+                    continue;
+                }
+
+                if(loc < 0)
+                {
+                    if(printWarnings)
+                        log.addUniformError("Shader variable '" + var + "' didn't exists.");
+
+                    continue;
+                }
+
+                UniformBinding binding;
+                binding.location = loc;
+                binding.size = u->getUniformSize();
+                binding.scalarType = u->getScalarType();
+                binding.variable = u;
+                binding.count = u->isArray() ? u->getVarCount() : 1;
+                binding.version = 0;
+
+                // user variable overrides built-in matrices
+                if(loc == table.mvpLocation)
+                    table.mvpLocation = -1;
+
+                if(loc == table.modelLocation)
+                    table.modelLocation = -1;
+
+                table.uniforms.append(binding);
+            }
+        }
+    }
+}
+
+/**
+ * @brief RenderCore::createTextureBindings Assign texture units to samplers of all loaded shader programs and set
+ * sampler uniforms. Shader programs with the same textures on the same units share texture set number,
+ * so textures are not bound again between them. Texture is attached only to sampler of its type.
+ * @param printWarnings If true print bad texture attachments to log.
+ */
+void RenderCore::createTextureBindings(bool printWarnings)
+{
+    QHash<QString,int> textureSets;
+
+    for(int i = 0; i < programTables.size(); ++i)
+    {
+        ProgramBindings& table = programTables[i];
+        const MetaShaderProg* program = programs.value(table.name);
+        table.textures.clear();
+
+        if(program == NULL)
+            continue;
+
+        QString setKey;
+        int counter = 0;
+        QHash<QString,GLenum> samplerTypes = getSamplerTypes(table.program->programId());
+
+        table.program->bind();
+
+        foreach(QString point, program->getTexturePoints())
+        {
+            QString name = program->getTexture(point);
+
+            if(!textures.contains(name))
+                continue;
+
+            int loc = table.program->uniformLocation(point);
+
+            if(loc == -1)
+            {
+                if(printWarnings)
+                    log.addToLog(tr("Bad attachment location %1 for texture %2!\n").arg(point, name));
+
+                continue;
+            }
+
+            GLTexture* texture = textures.value(name);
+
+            if(!texture->isSamplerCompatible(samplerTypes.value(point, 0)))
+            {
+                if(printWarnings)
+                    log.addToLog(tr("Type of sampler %1 does not match type of texture %2!\n").arg(point, name));
+
+                continue;
+            }
+
+            table.program->setUniformValue(loc, counter);
+
+            TextureBinding binding;
+            binding.texture = texture;
+            binding.unit = counter;
+            table.textures.append(binding);
+
+            setKey += QString("%1:%2;").arg(counter).arg(name);
+            ++counter;
+        }
+
+        if(!textureSets.contains(setKey))
+            textureSets.insert(setKey, textureSets.size());
+
+        table.textureSet = textureSets.value(setKey);
+    }
+
+    QGLShaderProgram::release();
+}
+
+/**
+ * @brief RenderCore::getSamplerTypes Get types of all active sampler uniforms of shader program.
+ * @param programId OpenGL identifier of linked shader program.
+ * @return Types of samplers under their names.
+ */
+QHash<QString,GLenum> RenderCore::getSamplerTypes(GLuint programId) const
+{
+    QHash<QString,GLenum> types;
+    GLint count = 0;
+    GLint maxLength = 0;
+
+    glGetProgramiv(programId, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(programId, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+    QByteArray name(qMax(maxLength, 1), 0);
+
+    for(GLint i = 0; i < count; ++i)
+    {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+
+        glGetActiveUniform(programId, i, name.size(), &length, &size, &type, name.data());
+
+        // arrays of samplers are reported with [0] suffix
+        QString uniform = QString::fromLatin1(name.constData(), length);
+
+        if(uniform.endsWith("[0]"))
+            uniform.chop(3);
+
+        types.insert(uniform, type);
+    }
+
+    return types;
+}
+
+/**
+ * @brief RenderCore::attachUniformBlocks Connect built-in and shared uniform blocks of shader program
+ * to their binding points. Layout of shared uniform block is read from the first shader program which declares it.
+ * @param table Binding table of the shader program.
+ */
+void RenderCore::attachUniformBlocks(ProgramBindings &table)
+{
+    GLuint programId = table.program->programId();
+
+    frameBlock.attachProgram(programId);
+    table.objectBlock = objectBlock.attachProgram(programId);
+
+    if(sharedBlock.attachProgram(programId) && !sharedBlock.readLayout(programId))
+    {
+        log.addUniformError(tr("Uniform block '%1' in shader program '%2' differs from other shader programs.")
+                            .arg(sharedBlock.getName(), table.name));
+    }
+}
+
+/**
+ * @brief RenderCore::updateUniformBlocks Pack built-in and shared uniform variables to uniform blocks and upload
+ * them once per frame. Per mesh values are stored for every item of draw list on its own aligned offset.
+ * @param viewProjection Actual projection and view matrix.
+ */
+void RenderCore::updateUniformBlocks(const QMatrix4x4 &viewProjection)
+{
+    float resolution[2] = {static_cast<float>(viewportWidth), static_cast<float>(viewportHeight)};
+    float time = frameTime.elapsed() / 1000.f;
+
+    frameBlock.setMatrix(FRAME_PROJECTION, frameProjection);
+    frameBlock.setMatrix(FRAME_VIEW, frameView);
+    frameBlock.setMatrix(FRAME_VIEW_PROJECTION, viewProjection);
+    frameBlock.setFloats(FRAME_RESOLUTION, resolution, 2);
+    frameBlock.setFloats(FRAME_TIME, &time, 1);
+    frameBlock.upload();
+    frameBlock.bindBase();
+
+    for(int i = 0; i < drawList.size(); ++i)
+    {
+        const DrawItem& item = drawList.at(i);
+        int offset = i * objectStride;
+
+        objectBlock.setMatrix(offset + OBJECT_MVP, viewProjection * item.world);
+        objectBlock.setMatrix(offset + OBJECT_MODEL, item.world);
+        objectBlock.setMatrix(offset + OBJECT_NORMAL, item.world.normalMatrix());
+    }
+
+    objectBlock.upload();
+
+    if(!sharedBlock.isCreated())
+        return;
+
+    QHashIterator<QString,UniformVariable*> it(sharedVariables);
+
+    while(it.hasNext())
+    {
+        it.next();
+
+        const UniformVariable* u = it.value();
+        const quint64 version = u->getVersion();
+
+        if(sharedVersions.value(it.key()) == version && !u->isMultiplyMode())
+            continue;
+
+        packSharedUniform(sharedBlock.getMember(it.key()), u, showErrors);
+        sharedVersions.insert(it.key(), version);
+    }
+
+    sharedBlock.upload();
+    sharedBlock.bindBase();
+}
+
+/**
+ * @brief RenderCore::packSharedUniform Write values of uniform variable to member of shared uniform block.
+ * @param member Layout of block member.
+ * @param u Uniform variable.
+ * @param printWarnings If true print errors of multiply variables to log.
+ */
+void RenderCore::packSharedUniform(const UniformBlock::Member &member, const UniformVariable *u, bool printWarnings)
+{
+    const int count = qMin(u->isArray() ? u->getVarCount() : 1, member.arraySize);
+    const bool multiply = u->isMultiplyMode();
+
+    // scalar array is copied from variable once, elements are placed by array stride
+    if(count > 1 && u->getUniformSize() == UniformTypes::SCALAR)
+    {
+        if(u->getScalarType() == UniformTypes::INT)
+        {
+            int* values = u->getValuesInt();
+
+            for(int i = 0; i < count; ++i)
+                sharedBlock.setData(member.offset + i * member.arrayStride, &values[i], sizeof(int));
+
+            delete[] values;
+        }
+        else if(u->getScalarType() == UniformTypes::UINT)
+        {
+            uint* values = u->getValuesUInt();
+
+            for(int i = 0; i < count; ++i)
+                sharedBlock.setData(member.offset + i * member.arrayStride, &values[i], sizeof(uint));
+
+            delete[] values;
+        }
+        else
+        {
+            float* values = u->getValuesFloat();
+
+            for(int i = 0; i < count; ++i)
+                sharedBlock.setFloats(member.offset + i * member.arrayStride, &values[i], 1);
+
+            delete[] values;
+        }
+
+        return;
+    }
+
+    for(int i = 0; i < count; ++i)
+    {
+        const int offset = member.offset + i * member.arrayStride;
+
+        switch(u->getUniformSize())
+        {
+        case UniformTypes::SCALAR:
+            if(u->getScalarType() == UniformTypes::INT)
+            {
+                int value = multiply ? calculateMultiplyScalar<int>(*u,printWarnings) : u->getValueInt();
+                sharedBlock.setData(offset, &value, sizeof(int));
+            }
+            else if(u->getScalarType() == UniformTypes::UINT)
+            {
+                uint value = multiply ? calculateMultiplyScalar<uint>(*u,printWarnings) : u->getValueUInt();
+                sharedBlock.setData(offset, &value, sizeof(uint));
+            }
+            else
+            {
+                float value = multiply ? calculateMultiplyScalar<float>(*u,printWarnings) : u->getValueFloat();
+                sharedBlock.setFloats(offset, &value, 1);
+            }
+            break;
+
+        case UniformTypes::VEC2:
+        {
+            QVector2D v = multiply ? calculateMultiplyVec2(*u,printWarnings) : u->getValueVec2D(i * 2);
+            float values[2] = {v.x(), v.y()};
+            sharedBlock.setFloats(offset, values, 2);
+            break;
+        }
+        case UniformTypes::VEC3:
+        {
+            QVector3D v = multiply ? calculateMultiplyVec3(*u,printWarnings) : u->getValueVec3D(i * 3);
+            float values[3] = {v.x(), v.y(), v.z()};
+            sharedBlock.setFloats(offset, values, 3);
+            break;
+        }
+        case UniformTypes::VEC4:
+        {
+            QVector4D v = multiply ? calculateMultiplyVec4(*u,printWarnings) : u->getValueVec4D(i * 4);
+            float values[4] = {v.x(), v.y(), v.z(), v.w()};
+            sharedBlock.setFloats(offset, values, 4);
+            break;
+        }
+
+        case UniformTypes::MAT2:
+        {
+            QMatrix2x2 m = multiply ? calculateMultiplyMat2x2(*u,printWarnings) : u->getValueMat2x2(i * 4);
+            sharedBlock.setMatrix(offset, m.constData(), 2, 2, member.matrixStride);
+            break;
+        }
+        case UniformTypes::MAT3:
+        {
+            QMatrix3x3 m = multiply ? calculateMultiplyMat3x3(*u,printWarnings) : u->getValueMat3x3(i * 9);
+            sharedBlock.setMatrix(offset, m.constData(), 3, 3, member.matrixStride);
+            break;
+        }
+        case UniformTypes::MAT4:
+        {
+            QMatrix4x4 m = multiply ? calculateMultiplyMat4x4(*u,printWarnings) : u->getValueMat4x4(i * 16);
+            sharedBlock.setMatrix(offset, m.constData(), 4, 4, member.matrixStride);
+            break;
+        }
+
+        default:
+            break;
+        }
+    }
+}
+
+/**
+ * @brief RenderCore::attachShaderUniform Attach uniform variable to shader program.
+ * @param binding Uniform variable with location in shader program.
+ * @param prog OpenGL shader program.
+ * @param printWarnings If true print errors of multiply variables to log.
+ */
+void RenderCore::attachShaderUniform(const UniformBinding &binding, QGLShaderProgram* prog, bool printWarnings)
+{
+    const UniformVariable* u = binding.variable;
+    const int loc = binding.location;
+    UniformTypes::UNIFORM_TYPES size = binding.size;
+    UniformTypes::UNIFORM_TYPES type = binding.scalarType;
+
+    switch(size){
+    case UniformTypes::SCALAR:
+        switch(type)
+        {
+        case UniformTypes::INT:
+            if(u->isMultiplyMode())
+            {
+                prog->setUniformValue(loc,calculateMultiplyScalar<int>(*u,printWarnings));
+            }
+            else if(binding.count > 1)
+            {
+                int *values = u->getValuesInt();
+                prog->setUniformValueArray(loc, values, binding.count);
+                delete values;
+            }
+            else
+                prog->setUniformValue(loc,u->getValueInt());
+            break;
+        case UniformTypes::UINT:
+            if(u->isMultiplyMode())
+            {
+                prog->setUniformValue(loc,calculateMultiplyScalar<uint>(*u,printWarnings));
+            }
+            else if(binding.count > 1)
+            {
+                uint *values = u->getValuesUInt();
+                prog->setUniformValueArray(loc, values, binding.count);
+                delete values;
+            }
+            else
+                prog->setUniformValue(loc,u->getValueUInt());
+            break;
+        case UniformTypes::FLOAT:
+            if(u->isMultiplyMode())
+            {
+                prog->setUniformValue(loc,calculateMultiplyScalar<float>(*u,printWarnings));
+                break;
+            }
+            else if(binding.count > 1)
+            {
+                float *values = u->getValuesFloat();
+                prog->setUniformValueArray(loc, values, binding.count, 1);
+                delete values;
+            }
+            else
+                prog->setUniformValue(loc,u->getValueFloat());
+            break;
+            /*
+        case DOUBLE:
+            prog->setUniformValue(loc,static_cast<float>(u->getValueDouble()));
+            break;
+            */
+        default:
+            prog->setUniformValue(loc,u->getValueInt());
+            break;
+        }
+
+        break;
+
+    case UniformTypes::VEC2:
+        if(u->isMultiplyMode())
+        {
+            prog->setUniformValue(loc,calculateMultiplyVec2(*u,printWarnings));
+        }
+        else if(binding.count > 1)
+        {
+            QVector2D *values = u->getValuesVec2D();
+            prog->setUniformValueArray(loc, values, binding.count);
+            delete values;
+        }
+        else
+            prog->setUniformValue(loc,u->getValueVec2D());
+        break;
+    case UniformTypes::VEC3:
+        if(u->isMultiplyMode())
+        {
+            prog->setUniformValue(loc,calculateMultiplyVec3(*u,printWarnings));
+        }
+        else if(binding.count > 1)
+        {
+            QVector3D *values = u->getValuesVec3D();
+            prog->setUniformValueArray(loc, values, binding.count);
+            delete values;
+        }
+        else
+            prog->setUniformValue(loc,u->getValueVec3D());
+        break;
+    case UniformTypes::VEC4:
+        if(u->isMultiplyMode())
+        {
+            prog->setUniformValue(loc,calculateMultiplyVec4(*u,printWarnings));
+        }
+        else if(binding.count > 1)
+        {
+            QVector4D *values = u->getValuesVec4D();
+            prog->setUniformValueArray(loc, values, binding.count);
+            delete values;
+        }
+        else
+            prog->setUniformValue(loc,u->getValueVec4D());
+        break;
+
+    case UniformTypes::MAT2:
+        if(u->isMultiplyMode())
+        {
+            prog->setUniformValue(loc,calculateMultiplyMat2x2(*u,printWarnings));
+        }
+        else if(binding.count > 1)
+        {
+            QMatrix2x2 *values = u->getValuesMat2x2();
+            prog->setUniformValueArray(loc, values, binding.count);
+            delete values;
+        }
+        else
+            prog->setUniformValue(loc,u->getValueMat2x2());
+        break;
+    case UniformTypes::MAT2X3:
+        break;
+    case UniformTypes::MAT2X4:
+        break;
+    case UniformTypes::MAT3:
+        if(u->isMultiplyMode())
+        {
+            prog->setUniformValue(loc,calculateMultiplyMat3x3(*u,printWarnings));
+        }
+        else if(binding.count > 1)
+        {
+            QMatrix3x3 *values = u->getValuesMat3x3();
+            prog->setUniformValueArray(loc, values, binding.count);
+            delete values;
+        }
+        else
+            prog->setUniformValue(loc,u->getValueMat3x3());
+        break;
+    case UniformTypes::MAT3X2:
+        break;
+    case UniformTypes::MAT3X4:
+        break;
+    case UniformTypes::MAT4:
+        if(u->isMultiplyMode())
+        {
+            prog->setUniformValue(loc,calculateMultiplyMat4x4(*u,printWarnings));
+        }
+        else if(binding.count > 1)
+        {
+            QMatrix4x4 *values = u->getValuesMat4x4();
+            prog->setUniformValueArray(loc, values, binding.count);
+            delete values;
+        }
+        else
+            prog->setUniformValue(loc,u->getValueMat4x4());
+        break;
+    case UniformTypes::MAT4X2:
+        break;
+    case UniformTypes::MAT4X3:
+        break;
+
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief RenderCore::createUniformTimers Create timers for ActionPressed and Time special variable.
+ * Append these and Action uniform variables to special lists for better working with it.
+ */
+void RenderCore::createUniformTimers()
+{
+    /*
+    qDeleteAll(uniformTimers);
+    uniformTimers.clear();
+    timeUniforms.clear();
+    pressedUniforms.clear();
+    */
+
+    /*
+    QStringList progNames = infoM->getActiveProject()->getProgramNames();
+
+    foreach(QString name, progNames)
+    {
+    */
+
+    QList<UniformVariable*> unifs = infoM->getActiveProject()->getUniformVariables();
+
+    foreach(UniformVariable* u, unifs)
+    {
+        QList<long> timers = u->getTimeTimers();
+
+        foreach(long t, timers)
+        {
+            DataTimer* timer = new DataTimer(t,DataTimer::TIME,this);
+            timer->setInterval(t);
+            timer->setSingleShot(false);
+            connect(timer,SIGNAL(timeout(long)),this,SLOT(incUnifTimeTimers(long)));
+
+            uniformTimers.append(timer);
+            timer->start();
+        }
+
+        if(!timers.isEmpty())
+            timeUniforms.append(u);
+
+        // action pressed
+        QList<long> pressedTimers = u->getActionPressedTimers();
+
+        foreach(long t, pressedTimers)
+        {
+            DataTimer* timer = new DataTimer(t, DataTimer::ACTION_PRESSED, this);
+            timer->setInterval(t);
+            timer->setSingleShot(false);
+            connect(timer,SIGNAL(timeout(long)),this,SLOT(incUnifActionPressedTimers(long)));
+
+            uniformTimers.append(timer);
+            timer->start();
+        }
+
+        if(!pressedTimers.isEmpty())
+            pressedUniforms.append(u);
+    }
+    //}
+}
+
+/**
+ * @brief RenderCore::resetUniformTimers Reset all uniform special variables to default values.
+ * Reset default projection and view variable too.
+ */
+void RenderCore::resetUniformTimers()
+{
+    // reset default variables
+    projection.setToIdentity();
+    projection.perspective(60,4.0/3.0,0.1,500.0);
+
+    view.setToIdentity();
+    view.translate(0.0,0.0,-4.0);
+    emit cameraReset();
+
+    // reset special variables
+    QList<UniformVariable*> unifs = infoM->getActiveProject()->getUniformVariables();
+
+    foreach(UniformVariable* u, unifs)
+    {
+        u->resetToDefaults();
+    }
+}
+
+/**
+ * @brief RenderCore::toggleAll For Action special variable. Toggle setted values to next value, if button with buttonId is pressed.
+ * @param buttonId Id of the button what we want toggle value.
+ */
+void RenderCore::toggleAll(int buttonId)
+{
+    if(isDrawPaused)
+        return;
+
+    QList<UniformVariable*> unifs = infoM->getActiveProject()->getUniformVariables();
+
+    foreach(UniformVariable* u, unifs)
+    {
+        u->toggleAction(buttonId);
+    }
+
+    requestUpdate();
+}
+
+/**
+ * @brief RenderCore::createNewBuffers Create new OpenGL bufers for setted model. All meshes are placed to one
+ * vertex buffer and one element buffer, offsets of mesh data are saved to meshes.
+ * @return Return false if some buffer canno't be bind or if vertices or indices are not found, true otherwise.
+ */
+bool RenderCore::createNewBuffers()
+{
+    Model* model = infoM->getActiveProject()->getModel();
+
+    const QList<Mesh*> list = model->getMeshes();
+
+    size_t vertexSize = 0;
+    size_t indexSize = 0;
+
+    // place mesh data to model buffers
+    foreach(Mesh* m, list)
+    {
+        m->clearBufferOffsets();
+
+        if(!m->hasVertices())
+        {
+            canRender = false;
+            log.addBufferError("Could not render without vertices!");
+            return false;
+        }
+
+        m->setVertexOffset(vertexSize);
+        vertexSize += m->getSizeVertices();
+
+        if(m->hasNormals())
+        {
+            m->setNormalOffset(vertexSize);
+            vertexSize += m->getSizeNormals();
+        }
+
+        if(m->hasColors())
+        {
+            for(unsigned int i = 0; i < m->getColorBuffersCount(); ++i)
+            {
+                m->addColorOffset(vertexSize);
+                vertexSize += m->getSizeColors(i);
+            }
+        }
+
+        if(m->hasTexCoords())
+        {
+            for(unsigned int i = 0; i < m->getTexCoordBuffersCount(); ++i)
+            {
+                m->addTexCoordOffset(vertexSize);
+                vertexSize += m->getSizeTexCoords(i);
+            }
+        }
+
+        if(m->hasIndices())
+        {
+            // 32-bit indices after 16-bit indices of previous mesh must be aligned
+            indexSize = (indexSize + 3) & ~static_cast<size_t>(3);
+
+            m->setIndexOffset(indexSize);
+            indexSize += m->getSizeIndices();
+
+            // simplified levels follow original indices
+            for(int lod = 1; lod < m->getLodCount(); ++lod)
+            {
+                m->addLodIndexOffset(indexSize);
+                indexSize += m->getSizeIndices(lod);
+            }
+        }
+    }
+
+    // core profile keeps element buffer binding in vertex array object
+    GLuint uploadArray;
+    glGenVertexArrays(1, &uploadArray);
+    glBindVertexArray(uploadArray);
+
+    bool ret = true;
+
+    // vertex buffer
+    modelVertexBuffer.create();
+    modelVertexBuffer.setUsagePattern(QGLBuffer::StaticDraw);
+
+    if(!modelVertexBuffer.bind())
+    {
+        log.addBufferError("Could not bind vertex buffer");
+        ret = false;
+    }
+    else
+    {
+        modelVertexBuffer.allocate(static_cast<int>(vertexSize));
+        char* data = static_cast<char*>(modelVertexBuffer.map(QGLBuffer::WriteOnly));
+
+        foreach(Mesh* m, list)
+        {
+            writeBufferData(modelVertexBuffer, data, m->getVertexOffset(), m->getVertices(), m->getSizeVertices());
+
+            if(m->hasNormals())
+                writeBufferData(modelVertexBuffer, data, m->getNormalOffset(), m->getNormals(), m->getSizeNormals());
+
+            for(unsigned int i = 0; i < m->getColorBuffersCount(); ++i)
+                writeBufferData(modelVertexBuffer, data, m->getColorOffset(i), m->getColors(i), m->getSizeColors(i));
+
+            for(unsigned int i = 0; i < m->getTexCoordBuffersCount(); ++i)
+                writeBufferData(modelVertexBuffer, data, m->getTexCoordOffset(i), m->getTexCoords(i), m->getSizeTexCoords(i));
+        }
+
+        if(data != NULL)
+            modelVertexBuffer.unmap();
+
+        modelVertexBuffer.release();
+    }
+
+    // index buffer
+    if(ret && indexSize != 0)
+    {
+        modelIndexBuffer.create();
+        modelIndexBuffer.setUsagePattern(QGLBuffer::StaticDraw);
+
+        if(!modelIndexBuffer.bind())
+        {
+            log.addBufferError("Could not bind index buffer");
+            ret = false;
+        }
+        else
+        {
+            modelIndexBuffer.allocate(static_cast<int>(indexSize));
+            char* data = static_cast<char*>(modelIndexBuffer.map(QGLBuffer::WriteOnly));
+
+            foreach(Mesh* m, list)
+            {
+                if(!m->hasIndices())
+                    continue;
+
+                for(int lod = 0; lod < m->getLodCount(); ++lod)
+                    writeIndexData(data, m, lod);
+            }
+
+            if(data != NULL)
+                modelIndexBuffer.unmap();
+        }
+    }
+
+    glBindVertexArray(0);
+    glDeleteVertexArrays(1, &uploadArray);
+
+    return ret;
+}
+
+/**
+ * @brief RenderCore::writeBufferData Copy data to model buffer. Buffer must be bound.
+ * @param buffer Buffer where we copy data.
+ * @param mapped Mapped memory of buffer, if NULL data are written through OpenGL.
+ * @param offset Offset in buffer (bytes).
+ * @param data Copied data.
+ * @param size Size of copied data (bytes).
+ */
+void RenderCore::writeBufferData(QGLBuffer &buffer, char *mapped, size_t offset, const void *data, size_t size)
+{
+    if(mapped != NULL)
+        memcpy(mapped + offset, data, size);
+    else
+        buffer.write(static_cast<int>(offset), data, static_cast<int>(size));
+}
+
+/**
+ * @brief RenderCore::writeIndexData Copy indices of one level of detail of mesh to model index buffer.
+ * Indices of meshes with less than 65537 vertices are converted to unsigned shorts. Index buffer must be bound.
+ * @param mapped Mapped memory of index buffer, if NULL data are written through OpenGL.
+ * @param mesh Mesh with placed indices.
+ * @param lod Level of detail.
+ */
+void RenderCore::writeIndexData(char *mapped, Mesh *mesh, int lod)
+{
+    if(!mesh->hasShortIndices())
+    {
+        writeBufferData(modelIndexBuffer, mapped, mesh->getIndexOffset(lod), mesh->getIndices(lod),
+                        mesh->getSizeIndices(lod));
+        return;
+    }
+
+    const unsigned int* indices = mesh->getIndices(lod);
+    QVector<GLushort> shortIndices(mesh->getNumberIndices(lod));
+
+    for(int i = 0; i < shortIndices.size(); ++i)
+        shortIndices[i] = static_cast<GLushort>(indices[i]);
+
+    writeBufferData(modelIndexBuffer, mapped, mesh->getIndexOffset(lod), shortIndices.constData(),
+                    mesh->getSizeIndices(lod));
+}
+
+/**
+ * @brief RenderCore::attachAttribBuffers Attach attributes from mesh to shader program.
+ * @param mesh Mesh of the model.
+ * @param program Shader program we want to use.
+ * @param writeErrors If true write errors to logging window.
+ * @return Return true if all buffer are binded correctly and vertices and indices exists, false otherwise.
+ */
+bool RenderCore::attachAttribBuffers(Mesh* mesh, const MetaShaderProg* program, bool writeErrors)
+{
+    QGLShaderProgram* m_shader = shaders.value(program->getName());
+
+    QGLBuffer::release(QGLBuffer::VertexBuffer);
+    QGLBuffer::release(QGLBuffer::IndexBuffer);
+
+    if(!m_shader->bind())
+    {
+        if(writeErrors)
+            log.addToLog("Could not bind shader program to context\n");
+
+        return false;
+    }
+
+    modelVertexBuffer.bind();
+
+    // attach vertices
+    if(mesh->hasVertices())
+    {
+        int loc = m_shader->attributeLocation(program->getVerticesAttach());
+        if(loc != -1)
+        {
+            m_shader->setAttributeBuffer(loc,GL_FLOAT,static_cast<int>(mesh->getVertexOffset()),3);
+            m_shader->enableAttributeArray(loc);
+        }
+        else
+        {
+            if(writeErrors)
+                log.addBufferError("Bad attachment location for vertices!");
+            return false;
+        }
+    }
+    else // canno't draw without vertices
+    {
+        log.addBufferError("Canno't attach vertices buffer");
+        return false;
+    }
+
+    // attach colors
+    if(mesh->hasColors() && program->isColors())
+    {
+        for(unsigned int i = 0; i < mesh->getColorBuffersCount(); ++i)
+        {
+            if(!program->isColor(i))
+                continue;
+
+            int loc = m_shader->attributeLocation(program->getColor(i));
+            if(loc != -1)
+            {
+                m_shader->setAttributeBuffer(loc,GL_FLOAT,static_cast<int>(mesh->getColorOffset(i)),4);
+                m_shader->enableAttributeArray(loc);
+            }
+            else
+            {
+                if(writeErrors)
+                    log.addBufferError(tr("Bad attachment location for colors!"));
+            }
+        }
+    }
+
+    if(mesh->hasTexCoords() && program->isTexCoords())
+    {
+        for(unsigned int i = 0; i < mesh->getTexCoordBuffersCount(); ++i)
+        {
+            if(!program->isTexCoord(i))
+                continue;
+
+            int loc = m_shader->attributeLocation(program->getTexCoord(i));
+            if(loc != -1)
+            {
+                m_shader->setAttributeBuffer(loc,GL_FLOAT,static_cast<int>(mesh->getTexCoordOffset(i)),2);
+                m_shader->enableAttributeArray(loc);
+            }
+            else
+            {
+                if(writeErrors)
+                    log.addBufferError(tr("Bad attachment location for texture coordinate %1!").arg(i));
+            }
+        }
+    }
+
+    // attach normals
+    if(mesh->hasNormals() && program->isNormals())
+    {
+        int loc = m_shader->attributeLocation(program->getNormalsAttach());
+        if(loc != -1)
+        {
+            m_shader->setAttributeBuffer(loc,GL_FLOAT,static_cast<int>(mesh->getNormalOffset()),3);
+            m_shader->enableAttributeArray(loc);
+
+            //qDebug() << "found normals attachment";
+        }
+        else
+        {
+            if(writeErrors)
+                log.addBufferError("Bad attachment location for normals!\n");
+        }
+
+    }
+
+    // attach indices
+    if(mesh->hasIndices())
+    {
+        modelIndexBuffer.bind();
+    }
+    else
+    {
+        if(writeErrors)
+            log.addBufferError("Canno't attach indices buffer");
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief RenderCore::createVertexArray Create vertex array object with attributes from mesh attached to shader program.
+ * @param mesh Mesh of the model.
+ * @param program Shader program we want to use.
+ * @param writeErrors If true write errors to logging window.
+ * @return Return vertex array object id or 0 if attributes canno't be attached.
+ */
+GLuint RenderCore::createVertexArray(Mesh *mesh, const MetaShaderProg *program, bool writeErrors)
+{
+    GLuint array;
+
+    glGenVertexArrays(1, &array);
+    glBindVertexArray(array);
+
+    if(!attachAttribBuffers(mesh, program, writeErrors))
+    {
+        glBindVertexArray(0);
+        glDeleteVertexArrays(1, &array);
+        return 0;
+    }
+
+    glBindVertexArray(0);
+
+    return array;
+}
+
+/**
+ * @brief RenderCore::removeVertexArrays Delete all cached vertex array objects.
+ */
+void RenderCore::removeVertexArrays()
+{
+    foreach(GLuint array, vertexArrays)
+    {
+        if(array != 0)
+            glDeleteVertexArrays(1, &array);
+    }
+
+    vertexArrays.clear();
+}
+
+/**
+ * @brief RenderCore::attachTextures Bind textures of shader program to their texture units.
+ * @param table Binding table of the shader program.
+ */
+void RenderCore::attachTextures(const ProgramBindings &table)
+{
+    const TextureBinding* binding = table.textures.constData();
+    const TextureBinding* end = binding + table.textures.size();
+
+    for(; binding != end; ++binding)
+    {
+        binding->texture->bindTexture(binding->unit);
+    }
+}
+
+/**
+ * @brief RenderCore::compileAllShaders Start compiling of all shader programs, if our shader program is valid.
+ * All shader objects are submitted first and then all shader programs are linked, so driver can compile them
+ * in parallel. Linked shader programs are cached in directory of the active project.
+ * @param programs Shader program with information how to create OpenGL shader.
+ * @return Return true if shaders are submitted correctly, false otherwise.
+ */
+bool RenderCore::compileAllShaders(QList<const MetaShaderProg *> programs)
+{
+    programCache.setDirectory(QDir(infoM->getActiveProject()->getProjAbsolutePath()).filePath(PROGRAM_CACHE_DIR));
+
+    log.newCompiling(); // erase log
+    compileTime.start();
+    usedShaderObjects.clear();
+
+    foreach(const MetaShaderProg* prog, programs)
+    {
+        if(!submitShaders(prog))
+        {
+            removePendingPrograms();
+            return false;
+        }
+    }
+
+    for(int i = 0; i < pendingPrograms.size(); ++i)
+    {
+        linkShaders(pendingPrograms.at(i));
+    }
+
+    return true;
+}
+
+/**
+ * @brief RenderCore::isCompileFinished Test without blocking if driver finished compiling and linking of all
+ * shader programs. Without parallel shader compile extension status query blocks, so true is returned.
+ * @return True if status of all shader programs can be read without waiting, false otherwise.
+ */
+bool RenderCore::isCompileFinished() const
+{
+    if(!parallelCompile)
+        return true;
+
+    foreach(const PendingProgram& pending, pendingPrograms)
+    {
+        if(pending.isCached)
+            continue;
+
+        GLint completed = GL_TRUE;
+        glGetProgramiv(pending.program->programId(), COMPLETION_STATUS, &completed);
+
+        if(completed != GL_TRUE)
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief RenderCore::finishAllShaders Test status of all compiled shader programs and log time of compiling.
+ * @return True if all shader programs are linked, false otherwise.
+ */
+bool RenderCore::finishAllShaders()
+{
+    bool isFailed = false;
+
+    for(int i = 0; i < pendingPrograms.size(); ++i)
+    {
+        if(!finishShaders(pendingPrograms[i]))
+            isFailed = true;
+    }
+
+    removePendingPrograms();
+    removeReusablePrograms();
+    removeShaderObjects(true);
+
+    log.addToCompiling(tr("Shader programs compiled and linked in %1 ms\n").arg(compileTime.elapsed()));
+
+    return !isFailed;
+}
+
+/**
+ * @brief RenderCore::isCompiling Test if some shader programs are compiled by driver.
+ * @return True if render core waits for shader programs, false otherwise.
+ */
+bool RenderCore::isCompiling() const
+{
+    return !pendingPrograms.isEmpty();
+}
+
+/**
+ * @brief RenderCore::removePendingPrograms Delete shader programs which were not used for drawing.
+ */
+void RenderCore::removePendingPrograms()
+{
+    // shader objects are owned by shader object cache
+    foreach(const PendingProgram& pending, pendingPrograms)
+    {
+        delete pending.program;
+    }
+
+    pendingPrograms.clear();
+}
+
+/**
+ * @brief RenderCore::createTextures Create new OpenGL textures. Textures with the same image file, modification time
+ * and parameters as before are taken from texture cache without loading, images of other textures are decoded
+ * in thread pool and uploaded by uploadDecodedTextures. Images with compression are encoded once and stored in
+ * texture cache directory of project. Cached textures which are not used anymore are deleted.
+ * @return Return true if nothing bad happen, otherwise false.
+ */
+bool RenderCore::createTextures()
+{
+    MetaProject* project = infoM->getActiveProject();
+    QStringList texList = project->getTextureNameList();
+    QHash<QString,GLTexture*> usedTextures;
+    QString cacheDir = QDir(project->getProjAbsolutePath()).filePath(TEXTURE_CACHE_DIR);
+
+    foreach(QString texName, texList)
+    {
+        TextureStorage* storage = project->getTexture(texName);
+
+        if(!storage->exists())
+        {
+            log.addToCompiling(tr("Texture %1 missing an image file!\n").arg(storage->getName()));
+            continue;
+        }
+
+        QString key = GLTexture::createCacheKey(storage);
+        GLTexture* texture = usedTextures.value(key, NULL);
+
+        if(texture == NULL)
+            texture = textureCache.take(key);
+
+        // create GLTexture object from copy of TextureStorage object
+        if(texture == NULL)
+        {
+            texture = new GLTexture(storage->copy());
+
+            if(!texture->createOGLTexture())
+            {
+                delete texture;
+                textureCache.unite(usedTextures);
+                return false;
+            }
+
+            // image is decoded in thread pool, texture shows placeholder until upload
+            texture->startDecoding(cacheDir, this, SLOT(textureDecoded()));
+            decodingTextures.append(texture);
+        }
+
+        usedTextures.insert(key, texture);
+        textures.insert(texName, texture);
+    }
+
+    foreach(GLTexture* texture, textureCache)
+    {
+        decodingTextures.removeAll(texture);
+    }
+
+    qDeleteAll(textureCache);
+    textureCache = usedTextures;
+
+    return true;
+}
+
+/**
+ * @brief RenderCore::uploadDecodedTextures Start streaming upload of images which were decoded in thread pool
+ * and replace placeholders of textures whose upload finished. OpenGL context must be current.
+ */
+void RenderCore::uploadDecodedTextures()
+{
+    bool isUploading = false;
+    QMutableListIterator<GLTexture*> it(decodingTextures);
+
+    while(it.hasNext())
+    {
+        GLTexture* texture = it.next();
+
+        if(texture->isUploading())
+        {
+            if(texture->finishUpload())
+            {
+                it.remove();
+                requestUpdate();
+            }
+            else
+                isUploading = true;
+
+            continue;
+        }
+
+        if(!texture->isDecoded())
+            continue;
+
+        // all buffers of uploader are still read, the rest of images is uploaded in next frames
+        if(!textureUploader.isReady())
+        {
+            isUploading = true;
+            continue;
+        }
+
+        if(texture->uploadDecodedImage(textureUploader))
+        {
+            isUploading = true;
+            continue;
+        }
+
+        log.addToCompiling(tr("Image of texture %1 canno't be loaded!\n").arg(texture->getName()));
+        it.remove();
+    }
+
+    // fences are tested again in next frame
+    if(isUploading)
+        requestUpdate();
+}
+
+/**
+ * @brief RenderCore::isLoadingTextures Test if some images of textures are decoded now.
+ * @return True if some texture shows placeholder, false otherwise.
+ */
+bool RenderCore::isLoadingTextures() const
+{
+    return !decodingTextures.isEmpty();
+}
+
+/**
+ * @brief RenderCore::isRenderValid Test if model can be rendered. It is if model is set, minimal one shader program is created and is valid.
+ * @return Return false if one of the conditions is not correct, false otherwise.
+ */
+bool RenderCore::isRenderValid()
+{
+    MetaProject* project = infoM->getActiveProject();
+
+    if(project == NULL)
+        return false;
+
+    if(!project->isModelLoaded())
+        return false;
+
+    ModelNode* node = project->getModel()->getRootNode();
+
+    if(node == NULL) // model is not set
+        return false;
+
+    //QList<MetaShaderProg *> list = infoM->getActiveProject()->getModel()->getAttachedPrograms();
+    QStringList programs = project->getModel()->getAttachedPrograms();
+    QList<MetaShaderProg *> list;
+
+    foreach(QString prog, programs)
+    {
+        MetaShaderProg* shProg = project->getProgram(prog);
+
+        if(shProg == NULL)
+            return false;
+
+        list.append(shProg);
+    }
+
+    if(list.isEmpty())
+        return false;
+
+    foreach(MetaShaderProg* prog, list)
+    {
+        if(!prog->isValid())
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief RenderCore::compileDrawList Create flat list of all mesh draws from model hierarchy.
+ * Must be called when model, shader programs or their attachments changed.
+ */
+void RenderCore::compileDrawList()
+{
+    drawList.clear();
+    isDrawListSorted = false;
+
+    QMatrix4x4 identity;
+    compileDrawList(rootNode, identity);
+
+    replicateDrawList();
+    batchInstances();
+
+    // results of occlusion queries belong to previous draws
+    for(int i = 0; i < drawList.size(); ++i)
+        drawList[i].occlusionId = i;
+
+    occlusionIssued.fill(false);
+
+    objectBlock.create(qMax(drawList.size(), 1) * objectStride);
+}
+
+/**
+ * @brief RenderCore::compileDrawList Recursively append mesh draws from node and its children to draw list.
+ * Create vertex array objects which are not cached yet.
+ * @param node Actual node of the model.
+ * @param parentWorld Transformation of the parent node to the world.
+ */
+void RenderCore::compileDrawList(ModelNode *node, const QMatrix4x4 &parentWorld)
+{
+    if(node == NULL)
+        return;
+
+    QMatrix4x4 world = parentWorld * node->getNodeTransformation();
+
+    foreach(Mesh* mesh, *node->getNodeMeshes())
+    {
+        QString name = node->getShaderProgram(mesh);
+        int id = programIds.value(name, -1);
+
+        if(id < 0 || !isShProgValid(name) || !mesh->hasIndices())
+            continue;
+
+        QPair<Mesh*,QString> key = qMakePair(mesh, name);
+
+        if(!vertexArrays.contains(key))
+            vertexArrays.insert(key, createVertexArray(mesh, programs.value(name), true));
+
+        GLuint array = vertexArrays.value(key);
+
+        if(array == 0)
+            continue;
+
+        // box around transformed corners of mesh box, scaled sphere keeps the same center
+        QVector3D boxMin = mesh->getBoundingMin();
+        QVector3D boxMax = mesh->getBoundingMax();
+
+        DrawItem item;
+        item.world = world;
+        item.worldCenter = world.map(mesh->getCenter());
+
+        for(int corner = 0; corner < 8; ++corner)
+        {
+            QVector3D point((corner & 1) ? boxMax.x() : boxMin.x(),
+                            (corner & 2) ? boxMax.y() : boxMin.y(),
+                            (corner & 4) ? boxMax.z() : boxMin.z());
+            point = world.map(point);
+
+            if(corner == 0)
+            {
+                item.worldMin = point;
+                item.worldMax = point;
+                continue;
+            }
+
+            item.worldMin = QVector3D(qMin(item.worldMin.x(), point.x()), qMin(item.worldMin.y(), point.y()),
+                                      qMin(item.worldMin.z(), point.z()));
+            item.worldMax = QVector3D(qMax(item.worldMax.x(), point.x()), qMax(item.worldMax.y(), point.y()),
+                                      qMax(item.worldMax.z(), point.z()));
+        }
+
+        float scale = qMax(qMax(world.column(0).toVector3D().length(), world.column(1).toVector3D().length()),
+                           world.column(2).toVector3D().length());
+
+        item.worldRadius = mesh->getBoundingRadius() * scale;
+        item.depth = 0.f;
+        item.visible = true;
+        item.lod = 0;
+        item.occlusionId = -1;
+        item.nodeIndex = node->getIndex();
+        item.mesh = mesh;
+        item.vertexArray = array;
+        item.programId = id;
+        item.textureSet = programTables.at(id).textureSet;
+        item.firstInstance = 0;
+        item.instanceCount = 1;
+
+        drawList.append(item);
+    }
+
+    foreach(ModelNode* childNode, *node->getChilds())
+    {
+        compileDrawList(childNode, world);
+    }
+}
+
+/**
+ * @brief RenderCore::replicateDrawList Copy compiled model to grid on xz plane by project settings. Copies are
+ * placed side by side with distance computed from box around the whole model.
+ */
+void RenderCore::replicateDrawList()
+{
+    MetaProject* project = infoM->getActiveProject();
+
+    if(project == NULL || drawList.isEmpty())
+        return;
+
+    const SettingsStorage* settings = project->getSettings();
+    const int columns = settings->getReplicationColumns();
+    const int rows = settings->getReplicationRows();
+
+    if(columns * rows <= 1)
+        return;
+
+    // box around the model in world coordinates
+    QVector3D min, max;
+    bool first = true;
+
+    foreach(const DrawItem& item, drawList)
+    {
+        if(first)
+        {
+            min = item.worldMin;
+            max = item.worldMax;
+            first = false;
+            continue;
+        }
+
+        min = QVector3D(qMin(min.x(), item.worldMin.x()), qMin(min.y(), item.worldMin.y()),
+                        qMin(min.z(), item.worldMin.z()));
+        max = QVector3D(qMax(max.x(), item.worldMax.x()), qMax(max.y(), item.worldMax.y()),
+                        qMax(max.z(), item.worldMax.z()));
+    }
+
+    float stepX = (max.x() - min.x()) * 1.25f;
+    float stepZ = (max.z() - min.z()) * 1.25f;
+
+    if(stepX <= 0.f)
+        stepX = 1.f;
+
+    if(stepZ <= 0.f)
+        stepZ = 1.f;
+
+    const QVector<DrawItem> model = drawList;
+
+    drawList.clear();
+    drawList.reserve(model.size() * columns * rows);
+
+    for(int row = 0; row < rows; ++row)
+    {
+        for(int column = 0; column < columns; ++column)
+        {
+            QMatrix4x4 offset;
+            offset.translate((column - (columns - 1) / 2.f) * stepX, 0.f, (row - (rows - 1) / 2.f) * stepZ);
+
+            foreach(DrawItem item, model)
+            {
+                item.world = offset * item.world;
+                item.worldCenter = offset.map(item.worldCenter);
+                item.worldMin = offset.map(item.worldMin);
+                item.worldMax = offset.map(item.worldMax);
+                drawList.append(item);
+            }
+        }
+    }
+}
+
+/**
+ * @brief RenderCore::batchInstances Join draws of the same mesh with the same shader program to one instanced draw.
+ * Only shader programs with instanceModelM attribute (mat4) are drawn with instancing, world matrices of instances
+ * are uploaded to instance buffer and attached to this attribute with divisor 1.
+ */
+void RenderCore::batchInstances()
+{
+    instanceBuffer.destroy();
+
+    QVector<DrawItem> items;
+    QVector<QVector<QMatrix4x4> > transforms;
+    QVector<QVector<DrawItem> > members;
+    QHash<QPair<Mesh*,int>,int> batches;
+
+    foreach(const DrawItem& item, drawList)
+    {
+        if(programTables.at(item.programId).instanceLocation == -1)
+        {
+            items.append(item);
+            transforms.append(QVector<QMatrix4x4>());
+            members.append(QVector<DrawItem>());
+            continue;
+        }
+
+        QPair<Mesh*,int> key = qMakePair(item.mesh, item.programId);
+
+        if(!batches.contains(key))
+        {
+            DrawItem batch = item;
+            batch.world.setToIdentity();
+            batch.worldCenter = QVector3D();
+
+            batches.insert(key, items.size());
+            items.append(batch);
+            transforms.append(QVector<QMatrix4x4>());
+            members.append(QVector<DrawItem>());
+        }
+
+        int id = batches.value(key);
+        DrawItem& batch = items[id];
+
+        batch.worldCenter += item.worldCenter;
+        batch.worldMin = QVector3D(qMin(batch.worldMin.x(), item.worldMin.x()),
+                                   qMin(batch.worldMin.y(), item.worldMin.y()),
+                                   qMin(batch.worldMin.z(), item.worldMin.z()));
+        batch.worldMax = QVector3D(qMax(batch.worldMax.x(), item.worldMax.x()),
+                                   qMax(batch.worldMax.y(), item.worldMax.y()),
+                                   qMax(batch.worldMax.z(), item.worldMax.z()));
+        transforms[id].append(item.world);
+        members[id].append(item);
+    }
+
+    QVector<GLfloat> data;
+
+    for(int i = 0; i < items.size(); ++i)
+    {
+        const QVector<QMatrix4x4>& instances = transforms.at(i);
+
+        if(instances.isEmpty())
+            continue;
+
+        DrawItem& item = items[i];
+        item.firstInstance = data.size() / 16;
+        item.instanceCount = instances.size();
+        item.worldCenter /= instances.size();
+        item.worldRadius = 0.f;
+
+        // sphere around average center which encloses spheres of all instances
+        foreach(const DrawItem& member, members.at(i))
+        {
+            float radius = (member.worldCenter - item.worldCenter).length() + member.worldRadius;
+            item.worldRadius = qMax(item.worldRadius, radius);
+        }
+
+        foreach(const QMatrix4x4& world, instances)
+        {
+            const float* values = world.constData();
+
+            for(int y = 0; y < 16; ++y)
+                data.append(values[y]);
+        }
+    }
+
+    drawList = items;
+
+    if(data.isEmpty())
+        return;
+
+    if(!instanceBuffer.create())
+    {
+        log.addBufferError(tr("Canno't create buffer for instance transformations"));
+        return;
+    }
+
+    instanceBuffer.setUsagePattern(QGLBuffer::StaticDraw);
+    instanceBuffer.bind();
+    instanceBuffer.allocate(data.constData(), data.size() * sizeof(GLfloat));
+
+    foreach(const DrawItem& item, drawList)
+    {
+        GLint location = programTables.at(item.programId).instanceLocation;
+
+        if(location != -1)
+            attachInstanceBuffer(item, location);
+    }
+
+    glBindVertexArray(0);
+    instanceBuffer.release();
+}
+
+/**
+ * @brief RenderCore::attachInstanceBuffer Attach range of instance buffer with transformations of instanced draw
+ * to its vertex array object. Instance buffer must be bound.
+ * @param item Instanced draw.
+ * @param location Location of first column of instanceModelM attribute.
+ */
+void RenderCore::attachInstanceBuffer(const DrawItem &item, GLint location)
+{
+    const size_t matrixSize = 16 * sizeof(GLfloat);
+    const size_t columnSize = 4 * sizeof(GLfloat);
+
+    glBindVertexArray(item.vertexArray);
+
+    // matrix attribute takes four locations, one for every column
+    for(int column = 0; column < 4; ++column)
+    {
+        size_t offset = item.firstInstance * matrixSize + column * columnSize;
+
+        glEnableVertexAttribArray(location + column);
+        glVertexAttribPointer(location + column, 4, GL_FLOAT, GL_FALSE, static_cast<GLsizei>(matrixSize),
+                              reinterpret_cast<const GLvoid*>(offset));
+        glVertexAttribDivisor(location + column, 1);
+    }
+}
+
+/**
+ * @brief RenderCore::sortDrawList Cull draw list by view frustum and sort it by shader program, textures
+ * and depth from front to back. Culling and sorting is done only when view or projection changed.
+ * @param viewProjection Actual projection and view matrix.
+ */
+void RenderCore::sortDrawList(const QMatrix4x4 &viewProjection)
+{
+    if(isDrawListSorted && drawListSortMatrix == viewProjection)
+        return;
+
+    cullDrawList(viewProjection);
+
+    for(int i = 0; i < drawList.size(); ++i)
+    {
+        DrawItem& item = drawList[i];
+        item.depth = (viewProjection * QVector4D(item.worldCenter, 1.f)).z();
+    }
+
+    std::sort(drawList.begin(), drawList.end());
+
+    drawListSortMatrix = viewProjection;
+    isDrawListSorted = true;
+}
+
+/**
+ * @brief RenderCore::cullDrawList Mark draws outside of view frustum as invisible. Planes of frustum are extracted
+ * from projection and view matrix, bounding sphere is tested first and box of draws which pass is tested
+ * against the same planes.
+ * @param viewProjection Actual projection and view matrix.
+ */
+void RenderCore::cullDrawList(const QMatrix4x4 &viewProjection)
+{
+    // left, right, bottom, top, near and far plane, normals point inside of frustum
+    QVector4D planes[6];
+    const QVector4D w = viewProjection.row(3);
+
+    for(int axis = 0; axis < 3; ++axis)
+    {
+        planes[axis * 2] = w + viewProjection.row(axis);
+        planes[axis * 2 + 1] = w - viewProjection.row(axis);
+    }
+
+    for(int i = 0; i < 6; ++i)
+    {
+        float length = planes[i].toVector3D().length();
+
+        if(length > 0.f)
+            planes[i] /= length;
+    }
+
+    drawnCount = 0;
+    culledCount = 0;
+
+    for(int i = 0; i < drawList.size(); ++i)
+    {
+        DrawItem& item = drawList[i];
+        item.visible = true;
+
+        for(int plane = 0; plane < 6 && item.visible; ++plane)
+        {
+            const QVector3D normal = planes[plane].toVector3D();
+            const float distance = planes[plane].w();
+
+            if(QVector3D::dotProduct(normal, item.worldCenter) + distance < -item.worldRadius)
+            {
+                item.visible = false;
+                break;
+            }
+
+            // corner of box farthest in direction of plane normal
+            QVector3D corner(normal.x() >= 0.f ? item.worldMax.x() : item.worldMin.x(),
+                             normal.y() >= 0.f ? item.worldMax.y() : item.worldMin.y(),
+                             normal.z() >= 0.f ? item.worldMax.z() : item.worldMin.z());
+
+            if(QVector3D::dotProduct(normal, corner) + distance < 0.f)
+                item.visible = false;
+        }
+
+        if(item.visible)
+        {
+            item.lod = selectLod(item, viewProjection);
+            drawnCount += item.instanceCount;
+        }
+        else
+            culledCount += item.instanceCount;
+    }
+}
+
+/**
+ * @brief RenderCore::selectLod Select level of detail of draw by height of its bounding sphere on screen.
+ * Level 0 is used when sphere covers at least LOD_SCREEN_SIZE of the screen height, every next level
+ * is used for half size of the previous one.
+ * @param item Tested draw.
+ * @param viewProjection Actual projection and view matrix.
+ * @return Level of detail which is available in mesh of draw.
+ */
+int RenderCore::selectLod(const DrawItem &item, const QMatrix4x4 &viewProjection) const
+{
+    const int last = item.mesh->getLodCount() - 1;
+
+    if(lodOverride >= 0)
+        return qMin(lodOverride, last);
+
+    if(last == 0)
+        return 0;
+
+    // distance from camera along view direction
+    const float w = (viewProjection * QVector4D(item.worldCenter, 1.f)).w();
+
+    if(w <= item.worldRadius)
+        return 0;
+
+    // part of screen height covered by sphere
+    float size = item.worldRadius * projection(1, 1) / w;
+    int lod = 0;
+
+    while(lod < last && size < LOD_SCREEN_SIZE)
+    {
+        size *= 2.f;
+        ++lod;
+    }
+
+    return lod;
+}
+
+/**
+ * @brief RenderCore::drawModel Draw compiled draw list of the model. Shader program, uniform variables and
+ * textures are set only when they differ from previous draw.
+ */
+void RenderCore::drawModel()
+{
+    if(isDrawPaused)
+        return;
+
+    if(!canRender || shaders.isEmpty() || dirtyFlags != DIRTY_NONE)
+        return;
+
+    const QMatrix4x4 viewProjection = mvpStack.top();
+    sortDrawList(viewProjection);
+    updateUniformBlocks(viewProjection);
+
+    const bool occlusion = isOcclusionActive();
+
+    if(occlusion)
+        readOcclusionQueries();
+    else
+        occludedCount = 0;
+
+    int lastProgram = -1;
+    int lastTextureSet = -1;
+    bool programReady = false;
+
+    // timestamp of frame start, every draw has timestamps before and after it
+    const bool timestamps = drawTiming && drawTimestamps.isUsable();
+
+    if(timestamps)
+        glQueryCounter(nextTimestampQuery(), GL_TIMESTAMP);
+
+    const DrawItem* item = drawList.constData();
+    const DrawItem* end = item + drawList.size();
+
+    for(; item != end; ++item)
+    {
+        if(!item->visible)
+            continue;
+
+        ProgramBindings& table = programTables[item->programId];
+
+        if(item->programId != lastProgram)
+        {
+            lastProgram = item->programId;
+            programReady = table.program->bind() && setShaderUniform(table, showErrors);
+        }
+
+        if(!programReady)
+            continue;
+
+        if(item->textureSet != lastTextureSet)
+        {
+            attachTextures(table);
+            lastTextureSet = item->textureSet;
+        }
+
+        setMVP(table, viewProjection * item->world, item->world);
+
+        if(table.objectBlock)
+            objectBlock.bindRange((item - drawList.constData()) * objectStride, OBJECT_BLOCK_SIZE);
+
+        glBindVertexArray(item->vertexArray);
+
+        if(timestamps)
+            glQueryCounter(nextTimestampQuery(), GL_TIMESTAMP);
+
+        GLint queryId = createQuery(table.name);
+
+        if(queryId >= 0)
+            glBeginQuery(GL_TIME_ELAPSED,queryId);
+
+        const GLenum indexType = item->mesh->hasShortIndices() ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+        const bool conditional = occlusion && occlusionIssued.value(item->occlusionId, false);
+
+        if(conditional)
+            glBeginConditionalRender(occlusionQueries.at(item->occlusionId), GL_QUERY_NO_WAIT);
+
+        if(table.instanceLocation != -1)
+            glDrawElementsInstanced(GL_TRIANGLES,item->mesh->getNumberIndices(item->lod),indexType,
+                                    reinterpret_cast<const GLvoid*>(item->mesh->getIndexOffset(item->lod)),
+                                    item->instanceCount);
+        else
+            glDrawElements(GL_TRIANGLES,item->mesh->getNumberIndices(item->lod),indexType,
+                           reinterpret_cast<const GLvoid*>(item->mesh->getIndexOffset(item->lod)));
+
+        if(conditional)
+            glEndConditionalRender();
+
+        if(queryId >= 0)
+            glEndQuery(GL_TIME_ELAPSED);
+
+        if(timestamps)
+        {
+            glQueryCounter(nextTimestampQuery(), GL_TIMESTAMP);
+            drawTimestamps.addDraw(item->nodeIndex, item->mesh->getIndex(), table.name, item->instanceCount);
+        }
+    }
+
+    glBindVertexArray(0);
+
+    if(occlusion)
+    {
+        drawOcclusionBoxes(viewProjection);
+
+        // draws were tested from other camera, in idle mode the next frame would not come after camera stops
+        if(viewProjection != occlusionMatrix)
+        {
+            occlusionMatrix = viewProjection;
+            requestUpdate();
+        }
+    }
+}
+
+/**
+ * @brief RenderCore::isOcclusionActive Test if occlusion culling can be used with actual settings. Occlusion
+ * needs depth test and depth writes, so it is not used with blending.
+ * @return True if occlusion queries are used in this frame.
+ */
+bool RenderCore::isOcclusionActive() const
+{
+    if(!occlusionCulling)
+        return false;
+
+    MetaProject* project = infoM->getActiveProject();
+
+    if(project == NULL)
+        return false;
+
+    const SettingsStorage* settings = project->getSettings();
+
+    return settings->isDepthTest() && !settings->isBlending();
+}
+
+/**
+ * @brief RenderCore::createOcclusionResources Create program, buffer and vertex array for drawing of bounding boxes.
+ * @return True if resources exist, false otherwise.
+ */
+bool RenderCore::createOcclusionResources()
+{
+    if(occlusionProgram != NULL)
+        return true;
+
+    QGLShaderProgram* program = new QGLShaderProgram(this);
+
+    if(!program->addShaderFromSourceCode(QGLShader::Vertex, OCCLUSION_VERTEX_SHADER) ||
+            !program->addShaderFromSourceCode(QGLShader::Fragment, OCCLUSION_FRAGMENT_SHADER) || !program->link())
+    {
+        log.addBufferError(tr("Canno't create program for occlusion queries:\n%1").arg(program->log()));
+        delete program;
+        occlusionCulling = false;
+        return false;
+    }
+
+    // unit cube as one triangle strip
+    static const GLfloat box[] = {0.f, 1.f, 1.f,  1.f, 1.f, 1.f,  0.f, 0.f, 1.f,  1.f, 0.f, 1.f,
+                                  1.f, 0.f, 0.f,  1.f, 1.f, 1.f,  1.f, 1.f, 0.f,  0.f, 1.f, 1.f,
+                                  0.f, 1.f, 0.f,  0.f, 0.f, 1.f,  0.f, 0.f, 0.f,  1.f, 0.f, 0.f,
+                                  0.f, 1.f, 0.f,  1.f, 1.f, 0.f};
+
+    glGenVertexArrays(1, &occlusionArray);
+    glBindVertexArray(occlusionArray);
+
+    occlusionBoxBuffer.create();
+    occlusionBoxBuffer.setUsagePattern(QGLBuffer::StaticDraw);
+    occlusionBoxBuffer.bind();
+    occlusionBoxBuffer.allocate(box, sizeof(box));
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, 0);
+
+    glBindVertexArray(0);
+    occlusionBoxBuffer.release();
+
+    occlusionTarget = (GLEW_VERSION_3_3 || GLEW_ARB_occlusion_query2) ? GL_ANY_SAMPLES_PASSED : GL_SAMPLES_PASSED;
+    occlusionProgram = program;
+
+    return true;
+}
+
+/**
+ * @brief RenderCore::removeOcclusionResources Delete queries, program and buffers of occlusion culling.
+ */
+void RenderCore::removeOcclusionResources()
+{
+    if(!occlusionQueries.isEmpty())
+        glDeleteQueries(occlusionQueries.size(), occlusionQueries.constData());
+
+    occlusionQueries.clear();
+    occlusionIssued.clear();
+
+    if(occlusionArray != 0)
+        glDeleteVertexArrays(1, &occlusionArray);
+
+    occlusionArray = 0;
+    occlusionBoxBuffer.destroy();
+
+    delete occlusionProgram;
+    occlusionProgram = NULL;
+}
+
+/**
+ * @brief RenderCore::readOcclusionQueries Count meshes which will be skipped by conditional rendering.
+ * Only results which are already available are read, so drawing does not wait for them.
+ */
+void RenderCore::readOcclusionQueries()
+{
+    occludedCount = 0;
+
+    foreach(const DrawItem& item, drawList)
+    {
+        if(!item.visible || !occlusionIssued.value(item.occlusionId, false))
+            continue;
+
+        const GLuint query = occlusionQueries.at(item.occlusionId);
+        GLuint available = 0;
+        glGetQueryObjectuiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+
+        if(!available)
+            continue;
+
+        GLuint samples = 0;
+        glGetQueryObjectuiv(query, GL_QUERY_RESULT, &samples);
+
+        if(samples == 0)
+            occludedCount += item.instanceCount;
+    }
+}
+
+/**
+ * @brief RenderCore::drawOcclusionBoxes Draw bounding boxes of visible draws with occlusion queries against
+ * depth of the whole drawn model. Results are used by conditional rendering in the next frame.
+ * Boxes are enlarged by small margin and tested with GL_LEQUAL, so mesh with faces on its own box does not hide
+ * itself. Boxes around camera are not tested, their draws are drawn without condition.
+ * @param viewProjection Actual projection and view matrix.
+ */
+void RenderCore::drawOcclusionBoxes(const QMatrix4x4 &viewProjection)
+{
+    if(!createOcclusionResources())
+        return;
+
+    // every draw has its own query
+    if(occlusionQueries.size() < drawList.size())
+    {
+        const int first = occlusionQueries.size();
+        occlusionQueries.resize(drawList.size());
+        glGenQueries(drawList.size() - first, occlusionQueries.data() + first);
+    }
+
+    occlusionIssued.resize(drawList.size());
+
+    const QVector3D camera = view.inverted().column(3).toVector3D();
+    const QVector3D margin(OCCLUSION_BOX_MARGIN, OCCLUSION_BOX_MARGIN, OCCLUSION_BOX_MARGIN);
+
+    occlusionProgram->bind();
+    const int mvpLocation = occlusionProgram->uniformLocation("mvp");
+
+    // faces of box can lie on surfaces of its own mesh, so equal depth must pass
+    GLint depthFunc = GL_LESS;
+    glGetIntegerv(GL_DEPTH_FUNC, &depthFunc);
+    const GLboolean cullFace = glIsEnabled(GL_CULL_FACE);
+
+    glBindVertexArray(occlusionArray);
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    glDepthMask(GL_FALSE);
+    glDepthFunc(GL_LEQUAL);
+    glDisable(GL_CULL_FACE);
+
+    foreach(const DrawItem& item, drawList)
+    {
+        const QVector3D boxMin = item.worldMin - margin;
+        const QVector3D boxMax = item.worldMax + margin;
+
+        const bool inside = camera.x() >= boxMin.x() && camera.y() >= boxMin.y() && camera.z() >= boxMin.z() &&
+                            camera.x() <= boxMax.x() && camera.y() <= boxMax.y() && camera.z() <= boxMax.z();
+
+        if(!item.visible || inside)
+        {
+            occlusionIssued[item.occlusionId] = false;
+            continue;
+        }
+
+        QMatrix4x4 boxWorld;
+        boxWorld.translate(boxMin);
+        boxWorld.scale(boxMax - boxMin);
+
+        occlusionProgram->setUniformValue(mvpLocation, viewProjection * boxWorld);
+
+        glBeginQuery(occlusionTarget, occlusionQueries.at(item.occlusionId));
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 14);
+        glEndQuery(occlusionTarget);
+
+        occlusionIssued[item.occlusionId] = true;
+    }
+
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    glDepthMask(GL_TRUE);
+    glDepthFunc(depthFunc);
+
+    if(cullFace)
+        glEnable(GL_CULL_FACE);
+
+    glBindVertexArray(0);
+
+    occlusionProgram->release();
+}
+
+/**
+ * @brief RenderCore::setNewSettings If something for drawing in application changed then this method will
+ *  rebuild only parts of the render state marked in dirtyFlags. Every flag is cleared after its part is rebuilt,
+ *  so failed part will be rebuilt again next time.
+ * @return Return false if we canno't use new settings.
+ */
+bool RenderCore::setNewSettings()
+{
+    MetaProject* project = infoM->getActiveProject();
+    ModelNode* node = project->getModel()->getRootNode();
+
+    if(node == NULL)
+    {
+        return false;
+    }
+
+    rootNode = node;
+    const int rebuild = dirtyFlags;
+
+    // block is destroyed with other OpenGL objects by releaseResources, existing block is kept
+    if(!frameBlock.create(FRAME_BLOCK_SIZE))
+        return false;
+
+    // rebuild can take more frames while programs are compiled, camera and values are reset only once
+    if((dirtyFlags & DIRTY_UNIFORMS) && !uniformsReset)
+    {
+        resetUniformTimers();
+        uniformsReset = true;
+    }
+
+    if(dirtyFlags & DIRTY_MODEL)
+    {
+        removeBuffers();
+
+        if(!createNewBuffers())
+            return false;
+
+        dirtyFlags &= ~DIRTY_MODEL;
+    }
+
+    if(dirtyFlags & DIRTY_PROGRAMS)
+    {
+        if(!isCompiling() || restartCompile)
+        {
+            keepLinkedPrograms();
+            removePrograms();
+            restartCompile = false;
+
+            //QList<MetaShaderProg *> outPrograms = infoM->getActiveProject()->getModel()->getAttachedPrograms();
+            QList<MetaShaderProg *> outPrograms = project->getPrograms();
+
+            if(outPrograms.isEmpty())
+                return false;
+
+            foreach(MetaShaderProg* prog, outPrograms)
+            {
+                this->programs.insert(prog->getName(), prog->copy());
+            }
+
+            if(!compileAllShaders(this->programs.values()))
+            {
+                return false;
+            }
+        }
+
+        // driver compiles shader programs, drawing waits for them without blocking user interface
+        if(!isCompileFinished())
+        {
+            requestUpdate();
+            return true;
+        }
+
+        if(!finishAllShaders())
+        {
+            return false;
+        }
+
+        createProgramTables();
+
+        dirtyFlags &= ~DIRTY_PROGRAMS;
+    }
+    else if(dirtyFlags & DIRTY_TEXTURES)
+    {
+        // texture attachments are stored in shader programs
+        refreshProgramCopies();
+    }
+
+    if(dirtyFlags & DIRTY_TEXTURES)
+    {
+        removeTextures();
+
+        if(!createTextures())
+            return false;
+
+        dirtyFlags &= ~DIRTY_TEXTURES;
+    }
+
+    if(dirtyFlags & DIRTY_UNIFORMS)
+    {
+        removeUniformTimers();
+        createUniformTimers();
+
+        dirtyFlags &= ~DIRTY_UNIFORMS;
+        uniformsReset = false;
+    }
+
+    if(rebuild & (DIRTY_PROGRAMS | DIRTY_UNIFORMS))
+        createUniformBindings(true);
+
+    if(rebuild & (DIRTY_PROGRAMS | DIRTY_TEXTURES))
+        createTextureBindings(true);
+
+    if(rebuild & (DIRTY_MODEL | DIRTY_PROGRAMS | DIRTY_TEXTURES | DIRTY_DRAW_LIST))
+        compileDrawList();
+
+    dirtyFlags &= ~DIRTY_DRAW_LIST;
+
+    showErrors = true;
+
+    canRender = true;
+    return true;
+}
+
+/**
+ * @brief RenderCore::removeSettings Clear old drawing settings.
+ */
+void RenderCore::removeSettings()
+{
+    removeOcclusionResources();
+    removeBuffers();
+    removePrograms();
+    removeReusablePrograms();
+    removeShaderObjects(false);
+    programKeys.clear();
+    removeTextureCache();
+}
+
+/**
+ * @brief RenderCore::removeBuffers Destroy model buffers and vertex array objects using them.
+ */
+void RenderCore::removeBuffers()
+{
+    drawList.clear();
+    removeVertexArrays();
+
+    modelVertexBuffer.destroy();
+    modelIndexBuffer.destroy();
+    instanceBuffer.destroy();
+}
+
+/**
+ * @brief RenderCore::removePrograms Remove shader programs and time queries measuring them.
+ */
+void RenderCore::removePrograms()
+{
+    removePendingPrograms();
+
+    qDeleteAll(programs);
+    programs.clear();
+
+    programTables.clear();
+    programIds.clear();
+    sharedVariables.clear();
+    sharedVersions.clear();
+    sharedBlock.clearLayout();
+    drawList.clear();
+    removeVertexArrays();
+
+    qDeleteAll(shaders);
+    shaders.clear();
+
+    removeQueries();
+    qDeleteAll(profiles);
+    profiles.clear();
+}
+
+/**
+ * @brief RenderCore::removeTextures Remove textures from drawing, OpenGL textures are kept in texture cache.
+ */
+void RenderCore::removeTextures()
+{
+    textures.clear();
+}
+
+/**
+ * @brief RenderCore::removeTextureCache Delete all OpenGL textures.
+ */
+void RenderCore::removeTextureCache()
+{
+    textures.clear();
+    decodingTextures.clear();
+    qDeleteAll(textureCache);
+    textureCache.clear();
+    textureUploader.destroy();
+}
+
+/**
+ * @brief RenderCore::removeUniformTimers Remove timers of special uniform variables.
+ */
+void RenderCore::removeUniformTimers()
+{
+    qDeleteAll(uniformTimers);
+    uniformTimers.clear();
+    timeUniforms.clear();
+    pressedUniforms.clear();
+}
+
+/**
+ * @brief RenderCore::refreshProgramCopies Replace copies of shader programs with actual project shader programs
+ * without compiling them again. Used when only attachments (textures) were changed.
+ */
+void RenderCore::refreshProgramCopies()
+{
+    MetaProject* project = infoM->getActiveProject();
+
+    foreach(QString name, programs.keys())
+    {
+        MetaShaderProg* prog = project->getProgram(name);
+
+        if(prog == NULL)
+            continue;
+
+        delete programs.value(name);
+        programs.insert(name, prog->copy());
+    }
+}
+
+/**
+ * @brief RenderCore::markDirty Mark parts of render state for rebuilding and plan one repaint.
+ * All changes from one event loop turn are merged to one rebuild.
+ * @param flags DIRTY_FLAGS what we want to rebuild.
+ */
+void RenderCore::markDirty(int flags)
+{
+    dirtyFlags |= flags;
+
+    // shader programs which are compiled now use old sources
+    if(flags & DIRTY_PROGRAMS)
+        restartCompile = true;
+
+    // new uniform values are reset again
+    if(flags & DIRTY_UNIFORMS)
+        uniformsReset = false;
+
+    requestUpdate();
+}
+
+/**
+ * @brief RenderCore::requestUpdate Plan repaint, more requests before repaint are joined to one.
+ */
+void RenderCore::requestUpdate()
+{
+    if(updatePending)
+        return;
+
+    updatePending = true;
+    QTimer::singleShot(0, this, SLOT(pendingUpdate()));
+}
+
+/**
+ * @brief RenderCore::createQuery Get next time query of shader program from its ring of queries. New OpenGL query
+ * is created only when the ring slot of actual frame has no unused query. Emit signals about creating new objects.
+ * @param progName Shader program name what we want create query.
+ * @return OpenGL query id, -1 if actual frame is not measured.
+ */
+GLint RenderCore::createQuery(const QString progName)
+{
+    TimeQueryStorage* query;
+
+    if(!profiles.contains(progName))
+    {
+        query = new TimeQueryStorage(progName);
+        query->beginFrame();
+        this->profiles.insert(progName, query);
+        emit queryCreated(progName);
+    }
+    else
+        query = profiles.value(progName);
+
+    if(!query->isUsable())
+        return -1;
+
+    if(query->needsQuery())
+    {
+        GLuint timeQuery;
+        //for drawing time measurement
+        glGenQueries(1, &timeQuery);
+        query->addQuery(timeQuery);
+    }
+
+    return query->nextQuery();
+}
+
+/**
+ * @brief RenderCore::testQuery Move time query measure objects to next slot of their rings.
+ * Slot which still waits for results is not used, the frame is not measured.
+ */
+void RenderCore::testQuery()
+{
+    foreach(TimeQueryStorage* s, profiles)
+        s->beginFrame();
+
+    if(drawTiming)
+        drawTimestamps.beginFrame();
+}
+
+/**
+ * @brief RenderCore::getQueryResults Finish queries of actual frame and read results of older frames. Only results
+ * which are already available are read, oldest frames first, so reading does not wait for GPU.
+ */
+void RenderCore::getQueryResults()
+{
+    foreach(TimeQueryStorage* q, profiles)
+    {
+        q->endFrame();
+
+        int frame = q->getOldestPending();
+
+        while(frame != -1)
+        {
+            const QVector<uint> queries = q->getFrameQueries(frame);
+            GLint available = GL_TRUE;
+
+            for(int i = queries.size() - 1; i >= 0 && available; --i)
+                glGetQueryObjectiv(queries.at(i), GL_QUERY_RESULT_AVAILABLE, &available);
+
+            if(!available)
+                break;
+
+            double elapsed = 0;
+
+            foreach(uint id, queries)
+            {
+                GLint64 qResult = 0;
+                glGetQueryObjecti64v(id, GL_QUERY_RESULT, &qResult);
+                elapsed += qResult;
+            }
+
+            q->setFrameTime(frame, elapsed);
+            frame = q->getOldestPending();
+        }
+    }
+
+    drawTimestamps.endFrame();
+
+    int frame = drawTimestamps.getOldestPending();
+
+    while(frame != -1)
+    {
+        const QVector<uint> queries = drawTimestamps.getFrameQueries(frame);
+        GLint available = GL_TRUE;
+
+        if(!queries.isEmpty())
+            glGetQueryObjectiv(queries.last(), GL_QUERY_RESULT_AVAILABLE, &available);
+
+        if(!available)
+            break;
+
+        QVector<qint64> results(queries.size());
+
+        for(int i = 0; i < queries.size(); ++i)
+        {
+            GLint64 qResult = 0;
+            glGetQueryObjecti64v(queries.at(i), GL_QUERY_RESULT, &qResult);
+            results[i] = qResult;
+        }
+
+        drawTimestamps.setFrameTimestamps(frame, results);
+        frame = drawTimestamps.getOldestPending();
+    }
+}
+
+/**
+ * @brief RenderCore::nextTimestampQuery Get next timestamp query of actual frame, new OpenGL query is created
+ * only when the ring slot has no unused query.
+ * @return OpenGL query id.
+ */
+GLuint RenderCore::nextTimestampQuery()
+{
+    if(drawTimestamps.needsQuery())
+    {
+        GLuint timestamp;
+        glGenQueries(1, &timestamp);
+        drawTimestamps.addQuery(timestamp);
+    }
+
+    return drawTimestamps.nextQuery();
+}
+
+/**
+ * @brief RenderCore::removeQueries Delete OpenGL queries of all time query measure objects and emit signals about this.
+ */
+void RenderCore::removeQueries()
+{
+    foreach(TimeQueryStorage* s, profiles)
+    {
+        const QVector<uint> queries = s->getAllQueries();
+
+        if(!queries.isEmpty())
+            glDeleteQueries(queries.size(), queries.constData());
+
+        emit queryDestroyed(s->getName());
+    }
+
+    const QVector<uint> timestamps = drawTimestamps.getAllQueries();
+
+    if(!timestamps.isEmpty())
+        glDeleteQueries(timestamps.size(), timestamps.constData());
+
+    drawTimestamps.clear();
+}
+
+/**
+ * @brief RenderCore::setMVP Set mvp and model matrix to shader program. Shader program must be bound.
+ * @param table Binding table of the shader program.
+ * @param mvp Model view projection matrix of actual mesh.
+ * @param modelMatrix Model matrix of actual mesh.
+ */
+void RenderCore::setMVP(const ProgramBindings &table, const QMatrix4x4 &mvp, const QMatrix4x4 &modelMatrix)
+{
+    QGLShaderProgram* glprog = table.program;
+
+    if(table.mvpLocation != -1)
+        glprog->setUniformValue(table.mvpLocation,mvp);
+
+    if(table.modelLocation != -1)
+        glprog->setUniformValue(table.modelLocation,modelMatrix);
+}
+
+/**
+ * @brief RenderCore::testProjection Test for uniform variable projection matrix. If not found standard projection matrix will be used.
+ */
+void RenderCore::testProjection()
+{
+    UniformVariable* var = infoM->getActiveProject()->getUniformVariable("projection");
+
+    mvpStack.clear();
+
+    if(var == NULL)
+        mvpStack.push(projection);
+    else
+    {
+        QMatrix4x4 p = var->getValueMat4x4();
+        mvpStack.push(p);
+    }
+
+    frameProjection = mvpStack.top();
+    frameView = view;
+    mvpStack.push(mvpStack.top() * view);
+}
+
+/**
+ * @brief RenderCore::testView Test uniform variable view matrix. If not exists use default view matrix.
+ */
+void RenderCore::testView()
+{
+    UniformVariable* var = infoM->getActiveProject()->getUniformVariable("view");
+
+    if(var == NULL)
+        return;
+    else
+    {
+        QMatrix4x4 v = calculateMultiplyMat4x4(*var, showErrors);
+        mvpStack.pop();
+        mvpStack.push(mvpStack.top() * v);
+        frameView = v;
+    }
+}
+
+/**
+ * @brief RenderCore::calculateMultiplyMat4x4 Calculate multiply matrices MAT4x4.
+ * @param variable This given uniform variable is in multiply mode.
+ * @param showErrors If print errors about bad matrices.
+ * @return Result of multiplication.
+ */
+QMatrix4x4 RenderCore::calculateMultiplyMat4x4(const UniformVariable &variable, bool showErrors)
+{
+    if(!variable.isMultiplyMode())
+    {
+        if(showErrors)
+            log.addUniformError(tr("Error uniform variable %1 is not in multiply mode").arg(variable.getName()));
+
+        return QMatrix4x4();
+    }
+
+    QString name = variable.getName();
+    QMatrix4x4 result;
+    MetaProject* proj = infoM->getActiveProject();
+
+    QList<QVariant> list = variable.getValues();
+
+    foreach(QVariant var, list)
+    {
+        UniformVariable* u = proj->getUniformVariable(var.toString());
+
+        if(!testMultiplyVar(name,var.toString(),u,showErrors))
+        {
+            return QMatrix4x4();
+        }
+
+        if(u->getUniformSize() != UniformTypes::MAT4)
+        {
+            if(showErrors)
+                log.addUniformError(tr("When computing multiply mode uniform variable %1, %2 is not Matrix 4x4!")
+                                    .arg(name, var.toString()));
+
+            return QMatrix4x4();
+        }
+
+        result *= u->getValueMat4x4();
+    }
+
+    return result;
+}
+
+/**
+ * @brief RenderCore::calculateMultiplyMat3x3 Calculate multiply matrices MAT3x3.
+ * @param variable This given uniform variable is in multiply mode.
+ * @param showErrors If print errors about bad matrices.
+ * @return Result of multiplication.
+ */
+QMatrix3x3 RenderCore::calculateMultiplyMat3x3(const UniformVariable &variable, bool showErrors)
+{
+    if(!variable.isMultiplyMode())
+    {
+        if(showErrors)
+            log.addUniformError(tr("Error uniform variable %1 is not in multiply mode").arg(variable.getName()));
+
+        return QMatrix3x3();
+    }
+
+    QString name = variable.getName();
+    QMatrix3x3 result;
+    MetaProject* proj = infoM->getActiveProject();
+
+    QList<QVariant> list = variable.getValues();
+
+    foreach(QVariant var, list)
+    {
+        UniformVariable* u = proj->getUniformVariable(var.toString());
+
+        if(!testMultiplyVar(name,var.toString(),u,showErrors))
+        {
+            return QMatrix3x3();
+        }
+
+        if(u->getUniformSize() != UniformTypes::MAT3)
+        {
+            if(showErrors)
+                log.addUniformError(tr("When computing multiply mode uniform variable %1, %2 is not Matrix 3x3!")
+                                    .arg(name, var.toString()));
+
+            return QMatrix3x3();
+        }
+
+        result = result * u->getValueMat3x3();
+    }
+
+    return result;
+}
+
+/**
+ * @brief RenderCore::calculateMultiplyMat2x2 Calculate multiply matrices MAT4x4.
+ * @param variable This given uniform variable is in multiply mode.
+ * @param showErrors If print errors about bad matrices.
+ * @return Result of multiplication.
+ */
+QMatrix2x2 RenderCore::calculateMultiplyMat2x2(const UniformVariable &variable, bool showErrors)
+{
+    if(!variable.isMultiplyMode())
+    {
+        if(showErrors)
+            log.addUniformError(tr("Error uniform variable %1 is not in multiply mode").arg(variable.getName()));
+
+        return QMatrix2x2();
+    }
+
+    QString name = variable.getName();
+    QMatrix2x2 result;
+    MetaProject* proj = infoM->getActiveProject();
+
+    QList<QVariant> list = variable.getValues();
+
+    foreach(QVariant var, list)
+    {
+        UniformVariable* u = proj->getUniformVariable(var.toString());
+
+        if(!testMultiplyVar(name,var.toString(),u,showErrors))
+        {
+            return QMatrix2x2();
+        }
+
+        if(u->getUniformSize() != UniformTypes::MAT2)
+        {
+            if(showErrors)
+                log.addUniformError(tr("When computing multiply mode uniform variable %1, %2 is not Matrix 2x2!")
+                                    .arg(name, var.toString()));
+
+            return QMatrix2x2();
+        }
+
+        result = result * u->getValueMat2x2();
+    }
+
+    return result;
+}
+
+/**
+ * @brief RenderCore::calculateMultiplyVec4 Calculate multiply vector VEC4.
+ * @param variable This given uniform variable is in multiply mode.
+ * @param showErrors If print errors about bad matrices.
+ * @return Result of multiplication.
+ */
+QVector4D RenderCore::calculateMultiplyVec4(const UniformVariable &variable, bool showErrors)
+{
+    if(!variable.isMultiplyMode())
+    {
+        if(showErrors)
+            log.addUniformError(tr("Error uniform variable %1 is not in multiply mode").arg(variable.getName()));
+
+        return QVector4D();
+    }
+
+    QString name = variable.getName();
+    QVector4D result;
+    MetaProject* proj = infoM->getActiveProject();
+
+    QList<QVariant> list = variable.getValues();
+
+    foreach(QVariant var, list)
+    {
+        UniformVariable* u = proj->getUniformVariable(var.toString());
+
+        if(!testMultiplyVar(name,var.toString(),u,showErrors))
+        {
+            return QVector4D();
+        }
+
+        if(u->getUniformSize() != UniformTypes::VEC4)
+        {
+            if(showErrors)
+                log.addUniformError(tr("When computing multiply mode uniform variable %1, %2 is not Matrix 4x4!")
+                                    .arg(name, var.toString()));
+
+            return QVector4D();
+        }
+
+        result *= u->getValueVec4D();
+    }
+
+    return result;
+}
+
+/**
+ * @brief RenderCore::calculateMultiplyVec3 Calculate multiply vector VEC3.
+ * @param variable This given uniform variable is in multiply mode.
+ * @param showErrors If print errors about bad matrices.
+ * @return Result of multiplication.
+ */
+QVector3D RenderCore::calculateMultiplyVec3(const UniformVariable &variable, bool showErrors)
+{
+    if(!variable.isMultiplyMode())
+    {
+        if(showErrors)
+            log.addUniformError(tr("Error uniform variable %1 is not in multiply mode").arg(variable.getName()));
+
+        return QVector3D();
+    }
+
+    QString name = variable.getName();
+    QVector3D result;
+    MetaProject* proj = infoM->getActiveProject();
+
+    QList<QVariant> list = variable.getValues();
+
+    foreach(QVariant var, list)
+    {
+        UniformVariable* u = proj->getUniformVariable(var.toString());
+
+        if(!testMultiplyVar(name,var.toString(),u,showErrors))
+        {
+            return QVector3D();
+        }
+
+        if(u->getUniformSize() != UniformTypes::VEC3)
+        {
+            if(showErrors)
+                log.addUniformError(tr("When computing multiply mode uniform variable %1, %2 is not Matrix 4x4!")
+                                    .arg(name, var.toString()));
+
+            return QVector3D();
+        }
+
+        result *= u->getValueVec3D();
+    }
+
+    return result;
+}
+
+/**
+ * @brief RenderCore::calculateMultiplyVec2 Calculate multiply vector VEC2.
+ * @param variable This given uniform variable is in multiply mode.
+ * @param showErrors If print errors about bad matrices.
+ * @return Result of multiplication.
+ */
+QVector2D RenderCore::calculateMultiplyVec2(const UniformVariable &variable, bool showErrors)
+{
+    if(!variable.isMultiplyMode())
+    {
+        if(showErrors)
+            log.addUniformError(tr("Error uniform variable %1 is not in multiply mode").arg(variable.getName()));
+
+        return QVector2D();
+    }
+
+    QString name = variable.getName();
+    QVector2D result;
+    MetaProject* proj = infoM->getActiveProject();
+
+    QList<QVariant> list = variable.getValues();
+
+    foreach(QVariant var, list)
+    {
+        UniformVariable* u = proj->getUniformVariable(var.toString());
+
+        if(!testMultiplyVar(name,var.toString(),u,showErrors))
+        {
+            return QVector2D();
+        }
+
+        if(u->getUniformSize() != UniformTypes::VEC2)
+        {
+            if(showErrors)
+                log.addUniformError(tr("When computing multiply mode uniform variable %1, %2 is not Matrix 4x4!")
+                                    .arg(name, var.toString()));
+
+            return QVector2D();
+        }
+
+        result *= u->getValueVec2D();
+    }
+
+    return result;
+}
+
+/**
+ * @brief RenderCore::convertToGLEnum Convert SettingStorage blend function enums to GLenum format.
+ * @param func SettingStorage enum for convertion.
+ * @return GLenum with the same meaning.
+ */
+GLenum RenderCore::convertToGLEnum(SettingsStorage::BLEND_FUNCTION func) const
+{
+    GLenum ret;
+
+    switch(func)
+    {
+    case SettingsStorage::ZERO:
+        ret = GL_ZERO;
+    case SettingsStorage::ONE:
+        ret = GL_ONE;
+    case SettingsStorage::DST_COLOR:
+        ret = GL_DST_COLOR;
+    case SettingsStorage::SRC_COLOR:
+        ret = GL_SRC_COLOR;
+    case SettingsStorage::ONE_MINUS_DST_COLOR:
+        ret = GL_ONE_MINUS_DST_COLOR;
+    case SettingsStorage::ONE_MINUS_SRC_COLOR:
+        ret = GL_ONE_MINUS_SRC_COLOR;
+    case SettingsStorage::SRC_ALPHA:
+        ret = GL_SRC_ALPHA;
+    case SettingsStorage::ONE_MINUS_SRC_ALPHA:
+        ret = GL_ONE_MINUS_SRC_ALPHA;
+    case SettingsStorage::DST_ALPHA:
+        ret = GL_DST_ALPHA;
+    case SettingsStorage::ONE_MINUS_DST_ALPHA:
+        ret = GL_ONE_MINUS_DST_ALPHA;
+    case SettingsStorage::SRC_ALPHA_SATURATE:
+        ret = GL_SRC_ALPHA_SATURATE;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief RenderCore::testMultiplyVar Test uniform variable if is multiply mode and if exists.
+ * @param name Name of the original multiply variable.
+ * @param innerVar Name of the inner variable of multiply variable.
+ * @param var Inner variable.
+ * @param showErrors If warning will be printed.
+ * @return True if test is ok, false if some error ocurse.
+ */
+bool RenderCore::testMultiplyVar(QString name, QString innerVar, UniformVariable *var, bool showErrors)
+{
+    if(!var)
+    {
+        if(showErrors)
+            log.addUniformError(tr("When computing multiply mode uniform variable %1, %2 variable do not exists!")
+                                .arg(name,innerVar));
+
+        return false;
+    }
+
+    if(var->isMultiplyMode())
+    {
+        if(showErrors)
+            log.addUniformError(tr("When computing multiply mode uniform variable %1, %2 variable canno't be multiply variable!")
+                                .arg(name,innerVar));
+
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief RenderCore::checkError Check if OpenGL reporting any error.
+ * @return Return error string if no error was created return empty string.
+ */
+QString RenderCore::checkError()
+{
+    GLenum e = glGetError();
+
+    switch(e)
+    {
+    case GL_NO_ERROR:
+        return "";
+    case GL_INVALID_ENUM:
+        return "An unacceptable value is specified for an enumerated argument. The offending command is ignored and has no other side effect than to set the error flag.";
+    case GL_INVALID_VALUE:
+        return "A numeric argument is out of range. The offending command is ignored and has no other side effect than to set the error flag.";
+    case GL_INVALID_OPERATION:
+        return "The specified operation is not allowed in the current state. The offending command is ignored and has no other side effect than to set the error flag.";
+    case GL_INVALID_FRAMEBUFFER_OPERATION:
+        return "The framebuffer object is not complete. The offending command is ignored and has no other side effect than to set the error flag.";
+    case GL_OUT_OF_MEMORY:
+        return "There is not enough memory left to execute the command. The state of the GL is undefined, except for the state of the error flags, after this error is recorded.";
+    case GL_STACK_UNDERFLOW:
+        return "An attempt has been made to perform an operation that would cause an internal stack to underflow.";
+    case GL_STACK_OVERFLOW:
+        return "An attempt has been made to perform an operation that would cause an internal stack to overflow.";
+    default:
+        return "";
+    }
+}
+
+/**
+ * @brief RenderCore::initialize Initialize extensions and OpenGL settings. OpenGL context must be current.
+ * @return True if extensions are loaded, false otherwise.
+ */
+bool RenderCore::initialize()
+{
+    glewExperimental = GL_TRUE;
+    if(glewInit() != GLEW_OK)
+    {
+        qWarning() << "Error could not initialize extensions";
+        return false;
+    }
+
+    if(!GLEW_VERSION_3_3)
+        qWarning() << "OpenGL version 3.3 is not supported";
+
+    if(!GLEW_ARB_vertex_array_object)
+        qWarning() << "Vertex array extension isn't here";
+
+    // Set the clear color to black
+    glClearColor( 0.0f, 0.0f, 0.0f, 1.0f );
+
+    //enable OpenGL functions
+    glEnable(GL_DEPTH_TEST);
+
+    // per mesh uniform block ranges must be aligned
+    int alignment = UniformBlock::getOffsetAlignment();
+    objectStride = ((OBJECT_BLOCK_SIZE + alignment - 1) / alignment) * alignment;
+
+    frameBlock.create(FRAME_BLOCK_SIZE);
+    frameTime.start();
+
+    // driver can compile shaders in its own threads
+    parallelCompile = false;
+
+#ifdef GL_KHR_parallel_shader_compile
+    if(GLEW_KHR_parallel_shader_compile)
+    {
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+        parallelCompile = true;
+    }
+#endif
+
+#ifdef GL_ARB_parallel_shader_compile
+    if(!parallelCompile && GLEW_ARB_parallel_shader_compile)
+    {
+        glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+        parallelCompile = true;
+    }
+#endif
+
+    if(!programCache.initialize())
+        qDebug() << "Program binaries are not supported, shader programs will be always compiled";
+
+    return true;
+}
+
+/**
+ * @brief RenderCore::resize Set new size of render target and viewport.
+ * @param w Horizontal size of render target.
+ * @param h Vertical size of render target.
+ */
+void RenderCore::resize(int w, int h)
+{
+    viewportWidth = qMax(w, 1);
+    viewportHeight = qMax(h, 1);
+
+    glViewport(0, 0, viewportWidth, viewportHeight);
+}
+
+/**
+ * @brief RenderCore::setView Set view matrix of the camera, it is used when project does not have view uniform variable.
+ * @param view View matrix.
+ */
+void RenderCore::setView(const QMatrix4x4 &view)
+{
+    this->view = view;
+}
+
+/**
+ * @brief RenderCore::render Draw one frame of the active project to bound framebuffer. OpenGL context must be current.
+ */
+void RenderCore::render()
+{
+    if(dirtyFlags & DIRTY_GL_SETTINGS)
+    {
+        applyOpenGLSettings();
+        dirtyFlags &= ~DIRTY_GL_SETTINGS;
+    }
+
+    // clear color buffer and depth buffer
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    uploadDecodedTextures();
+
+    if(!canRender)
+        return;
+
+    if(dirtyFlags != DIRTY_NONE)
+    {
+        if(!setNewSettings())
+        {
+            canRender = false;
+            removePendingPrograms();
+            return;
+        }
+    }
+
+    testQuery();
+
+    //mvpStack.push_back(mvpStack.top() * view);
+    testProjection();
+    testView();
+    //m_shader->setUniformValue(mvp_loc,mvpStack.top());
+
+    drawModel();
+
+    mvpStack.pop();
+
+    QString error = checkError();
+
+    if((!error.isEmpty()) && showErrors)
+        log.addToLog("OpenGL ERROR:" + error + '\n');
+
+    showErrors = false;
+
+    getQueryResults();
+}
+
+/** SLOTS **/
+
+/**
+ * @brief RenderCore::pendingUpdate Repaint planned by markDirty, rebuild of the render state is done in render.
+ */
+void RenderCore::pendingUpdate()
+{
+    updatePending = false;
+    emit updateRequested();
+}
+
+/**
+ * @brief RenderCore::textureDecoded Image of texture was decoded, it is uploaded before next drawing.
+ */
+void RenderCore::textureDecoded()
+{
+    requestUpdate();
+}
+
+/**
+ * @brief RenderCore::incUnifTimeTimers Increment uniform special variable $Time{inc,time,default=0,max=0}.
+ * If timer will timeout interval call this method.
+ * @param id Id of the setted timer. It is the interval which the timer waiting.
+ */
+void RenderCore::incUnifTimeTimers(long id)
+{
+    if(!canRender || isDrawPaused)
+        return;
+
+    foreach(UniformVariable* u, timeUniforms)
+    {
+        u->incrementTimeTimers(id);
+    }
+
+    requestUpdate();
+}
+
+/**
+ * @brief RenderCore::incUnifActionPressedTimers Increment uniform special variable
+ * $ActionPressed{BtnId,time,true value,false value,default=0}.
+ * If timer will timeout interval id call this method.
+ * If user pressing button (BtnId) then increment base value with true value, if not increment base value with false value.
+ * @param id Id of the setted timer. It is the interval which the timer waiting.
+ */
+void RenderCore::incUnifActionPressedTimers(long id)
+{
+    if(!canRender || isDrawPaused)
+        return;
+
+    foreach(UniformVariable* u, pressedUniforms)
+    {
+        u->incrementActionPressedTimers(id, buttonPressedField);
+    }
+
+    requestUpdate();
+}
+
+/**
+ * @brief RenderCore::setButtonPressed Remember state of button under OpenGL window for ActionPressed variables.
+ * Pressing of button toggle all Action variables.
+ * @param buttonId Identifier of button.
+ * @param pressed True if button was pressed, false if released.
+ */
+void RenderCore::setButtonPressed(int buttonId, bool pressed)
+{
+    if(buttonId < 0 || buttonId >= 15)
+        return;
+
+    buttonPressedField[buttonId] = pressed;
+
+    if(pressed)
+        toggleAll(buttonId);
+}
+
+/**
+ * @brief RenderCore::isButtonPressed Test if button under OpenGL window is pressed.
+ * @param buttonId Identifier of button.
+ * @return True if button is pressed, false otherwise.
+ */
+bool RenderCore::isButtonPressed(int buttonId) const
+{
+    if(buttonId < 0 || buttonId >= 15)
+        return false;
+
+    return buttonPressedField[buttonId];
+}
+
+/**
+ * @brief RenderCore::setOpenGLSettings Project options for OpenGL changed, they will be set before next drawing.
+ * Draw list is compiled again because replication of the model can change.
+ */
+void RenderCore::setOpenGLSettings()
+{
+    markDirty(DIRTY_GL_SETTINGS | DIRTY_DRAW_LIST);
+}
+
+/**
+ * @brief RenderCore::applyOpenGLSettings Set project options to OpenGL. OpenGL context must be current.
+ */
+void RenderCore::applyOpenGLSettings()
+{
+    MetaProject* actProj = infoM->getActiveProject();
+
+    if(actProj == NULL)
+        return;
+
+    SettingsStorage* settings = actProj->getSettings();
+
+    // clear color
+    const float *colors = settings->getBackgroundColors();
+    glClearColor(colors[0], colors[1], colors[2], colors[3]);
+
+    // blending
+    if(settings->isBlending())
+    {
+        glEnable(GL_BLEND);
+        glDepthMask(0);
+
+        GLenum sFactor = convertToGLEnum(settings->getBlendSFactor());
+        GLenum dFactor = convertToGLEnum(settings->getBlendDFactor());
+
+        glBlendFunc(sFactor, dFactor);
+    }
+    else {
+        glDisable(GL_BLEND);
+        glDepthMask(1);
+    }
+
+    // depth test
+    if(settings->isDepthTest())
+        glEnable(GL_DEPTH_TEST);
+    else
+        glDisable(GL_DEPTH_TEST);
+}
+
+
+/**
+ * @brief RenderCore::runShaders Set new shaders for drawing.
+ */
+void RenderCore::runShaders()
+{
+    qDebug() << "Loading new shaders to OpenGL window";
+
+    if(!isRenderValid())
+    {
+        canRender = false;
+        return;
+    }
+
+    //setNewSettings();
+    canRender = true;
+    markDirty(DIRTY_ALL);
+}
+
+/**
+ * @brief RenderCore::loadNewModel Load new 3D model for drawing.
+ */
+void RenderCore::loadNewModel()
+{
+    qDebug() << "Loading new model to OpenGL window";
+
+    if(!isRenderValid())
+    {
+        canRender = false;
+        return;
+    }
+
+    //setNewSettings();
+
+    canRender = true;
+    markDirty(DIRTY_MODEL);
+}
+
+/**
+ * @brief RenderCore::reloadShaderPrograms Load new settings for shader programs.
+ */
+void RenderCore::reloadShaderPrograms()
+{
+    qDebug() << "Refresh settings from shader programs.";
+
+    if(!isRenderValid())
+        return;
+
+    //setNewSettings();
+
+    canRender = true;
+    markDirty(DIRTY_PROGRAMS);
+}
+
+/**
+ * @brief RenderCore::newTextures Textures for drawing was changed, we need to create new one for OpenGL.
+ */
+void RenderCore::newTextures()
+{
+    qDebug() << "Create new textures for OpenGL.";
+
+    if(!isRenderValid())
+        return;
+
+    canRender = true;
+    markDirty(DIRTY_TEXTURES);
+}
+
+/**
+ * @brief RenderCore::newUniformValues New uniform variables was setted, load new settings.
+ */
+void RenderCore::newUniformValues()
+{
+    qDebug() << "Create new uniform values";
+
+    if(!isRenderValid())
+        return;
+
+    canRender = true;
+    markDirty(DIRTY_UNIFORMS);
+}
+
+/**
+ * @brief RenderCore::pauseDrawing Pause drawing for few moments.
+ * @param pause True if we want pause drawing, false otherwise.
+ */
+void RenderCore::pauseDrawing(bool pause)
+{
+    isDrawPaused = pause;
+
+    if(!pause)
+        requestUpdate();
+}
@@ -0,0 +1,459 @@
+#ifndef RENDERCORE_H
+#define RENDERCORE_H
+
+#define GLEW_STATIC
+#include <GL/glew.h>
+#include <QObject>
+#include <QTextEdit>
+#include <QGLShaderProgram>
+#include <QGLBuffer>
+#include <QTimer>
+#include <QVariant>
+#include <QList>
+#include <QVector>
+#include <QStack>
+#include <QSet>
+#include <QElapsedTimer>
+#include "infomanager.h"
+#include "logeditor.h"
+#include "model_work/storage/modelnode.h"
+#include "uniform/storage/uniformvariable.h"
+#include "storage/gltexture.h"
+#include "storage/uniformblock.h"
+#include "storage/programbinarycache.h"
+#include "profiling/timequerystorage.h"
+#include "profiling/drawtimestamps.h"
+#include "tools/datatimer.h"
+
+/**
+ * @brief The RenderCore class Render state of the active project: buffers, shader programs, textures, uniform variables
+ * and drawing of the model. Render core does not own OpenGL context, it draws to the framebuffer bound
+ * in context which is current when its methods are called. So it can draw to window or to offscreen framebuffer.
+ */
+class RenderCore : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * @brief The DIRTY_FLAGS enum Parts of render state which need to be rebuilt before next drawing.
+     */
+    enum DIRTY_FLAGS {DIRTY_NONE = 0, DIRTY_MODEL = 1, DIRTY_PROGRAMS = 2, DIRTY_TEXTURES = 4,
+                      DIRTY_UNIFORMS = 8, DIRTY_GL_SETTINGS = 16, DIRTY_DRAW_LIST = 32,
+                      DIRTY_ALL = DIRTY_MODEL | DIRTY_PROGRAMS | DIRTY_TEXTURES | DIRTY_UNIFORMS | DIRTY_GL_SETTINGS |
+                                  DIRTY_DRAW_LIST};
+
+    /**
+     * @brief The FRAME_BLOCK_OFFSETS enum Std140 offsets of built-in per frame uniform block members.
+     */
+    enum FRAME_BLOCK_OFFSETS {FRAME_PROJECTION = 0, FRAME_VIEW = 64, FRAME_VIEW_PROJECTION = 128,
+                              FRAME_RESOLUTION = 192, FRAME_TIME = 200, FRAME_BLOCK_SIZE = 208};
+
+    /**
+     * @brief The OBJECT_BLOCK_OFFSETS enum Std140 offsets of built-in per mesh uniform block members.
+     */
+    enum OBJECT_BLOCK_OFFSETS {OBJECT_MVP = 0, OBJECT_MODEL = 64, OBJECT_NORMAL = 128, OBJECT_BLOCK_SIZE = 176};
+
+    explicit RenderCore(QTextEdit *edit, QObject *parent = 0);
+    ~RenderCore();
+
+    const TimeQueryStorage* getTimeQuery(const QString progName);
+    QList<const TimeQueryStorage*> getTimeQueries();
+    int getDrawnCount() const;
+    int getCulledCount() const;
+    void setLodOverride(int level);
+    int getLodOverride() const;
+    void setOcclusionCulling(bool enabled);
+    bool isOcclusionCulling() const;
+    int getOccludedCount() const;
+    void setDrawTiming(bool enabled);
+    bool isDrawTiming() const;
+    QVector<DrawTimestamps::DrawTiming> getDrawTimings() const;
+    qint64 getDrawFrameTime() const;
+
+    void invalidateRender();
+    void releaseResources();
+    void requestUpdate();
+    bool isCompiling() const;
+    bool isLoadingTextures() const;
+
+    bool initialize();
+    void resize(int w, int h);
+    void render();
+    void setView(const QMatrix4x4 &view);
+
+    void setButtonPressed(int buttonId, bool pressed);
+    bool isButtonPressed(int buttonId) const;
+
+private:
+    /**
+     * @brief The UniformBinding struct Uniform variable attachment resolved to shader location after link.
+     */
+    struct UniformBinding {
+        GLint location;
+        UniformTypes::UNIFORM_TYPES size;
+        UniformTypes::UNIFORM_TYPES scalarType;
+        UniformVariable* variable;
+        int count;
+        quint64 version;
+    };
+
+    /**
+     * @brief The TextureBinding struct Texture attached to texture unit of shader program sampler.
+     */
+    struct TextureBinding {
+        GLTexture* texture;
+        int unit;
+    };
+
+    /**
+     * @brief The ProgramBindings struct Binding table of one shader program, walked on every draw.
+     */
+    struct ProgramBindings {
+        ProgramBindings() : program(NULL), mvpLocation(-1), modelLocation(-1), instanceLocation(-1), textureSet(0),
+            objectBlock(false) {}
+
+        QString name;
+        QGLShaderProgram* program;
+        GLint mvpLocation;
+        GLint modelLocation;
+        GLint instanceLocation;
+        QVector<UniformBinding> uniforms;
+        QVector<TextureBinding> textures;
+        int textureSet;
+        bool objectBlock;
+    };
+
+    /**
+     * @brief The PendingProgram struct Shader program submitted to driver, its status is tested after compiling.
+     */
+    struct PendingProgram {
+        QString name;
+        QGLShaderProgram* program;
+        GLuint vertexShader;
+        GLuint fragmentShader;
+        QByteArray cacheKey;
+        bool isCached;
+    };
+
+    /**
+     * @brief The ShaderObject struct Compiled shader object shared by shader programs and hash of its source.
+     */
+    struct ShaderObject {
+        GLuint shader;
+        QByteArray hash;
+    };
+
+    /**
+     * @brief The DrawItem struct One mesh draw of the compiled model. Draw list is sorted by shader program,
+     * textures and depth. Instanced draw has identity world matrix, transformations of its instances
+     * are stored in instance buffer. Box and sphere in world coordinates enclose all instances of the draw.
+     */
+    struct DrawItem {
+        QMatrix4x4 world;
+        QVector3D worldCenter;
+        QVector3D worldMin;
+        QVector3D worldMax;
+        float worldRadius;
+        float depth;
+        bool visible;
+        int lod;
+        int occlusionId;
+        unsigned int nodeIndex;
+        Mesh* mesh;
+        GLuint vertexArray;
+        int programId;
+        int textureSet;
+        int firstInstance;
+        int instanceCount;
+
+        bool operator<(const DrawItem& other) const
+        {
+            if(programId != other.programId)
+                return programId < other.programId;
+
+            if(textureSet != other.textureSet)
+                return textureSet < other.textureSet;
+
+            return depth < other.depth;
+        }
+    };
+
+    QString checkError();
+
+    //work with shader uniform variables
+    bool setShaderUniform(ProgramBindings &table, bool printWarning = false);
+    void attachShaderUniform(const UniformBinding &binding, QGLShaderProgram *prog, bool printWarnings);
+    void createProgramTables();
+    void createUniformBindings(bool printWarnings);
+    void createTextureBindings(bool printWarnings);
+    QHash<QString,GLenum> getSamplerTypes(GLuint programId) const;
+    void attachUniformBlocks(ProgramBindings &table);
+    void updateUniformBlocks(const QMatrix4x4 &viewProjection);
+    void packSharedUniform(const UniformBlock::Member &member, const UniformVariable *u, bool printWarnings);
+    void createUniformTimers();
+    void resetUniformTimers();
+
+    void toggleAll(int buttonId);
+
+    bool createNewBuffers();
+    void writeBufferData(QGLBuffer &buffer, char *mapped, size_t offset, const void *data, size_t size);
+    void writeIndexData(char *mapped, Mesh *mesh, int lod);
+    bool attachAttribBuffers(Mesh *mesh, const MetaShaderProg *program, bool writeErrors = false);
+    GLuint createVertexArray(Mesh *mesh, const MetaShaderProg *program, bool writeErrors = false);
+    void removeVertexArrays();
+    void attachTextures(const ProgramBindings &table);
+    bool submitShaders(const MetaShaderProg *prog);
+    GLuint getShaderObject(GLenum type, const QString path, const QByteArray &source);
+    void removeShaderObjects(bool unusedOnly);
+    void keepLinkedPrograms();
+    void removeReusablePrograms();
+    GLuint compileShader(GLenum type, const QByteArray &source);
+    void linkShaders(const PendingProgram &pending);
+    bool isShaderCompiled(GLuint shader) const;
+    QString getShaderLog(GLuint shader) const;
+    bool finishShaders(PendingProgram &pending);
+    bool compileAllShaders(QList<const MetaShaderProg *> programs);
+    bool isCompileFinished() const;
+    bool finishAllShaders();
+    void removePendingPrograms();
+
+    bool createTextures();
+    void uploadDecodedTextures();
+
+    bool isRenderValid();
+    /**
+     * @brief isShProgValid Test shader program if is valid, testing is with internal database.
+     * @param progName Shader program name.
+     * @return Return true if we can use this shader program, false otherwise.
+     */
+    inline bool isShProgValid(const QString progName) {return programs.contains(progName);}
+    void compileDrawList();
+    void compileDrawList(ModelNode *node, const QMatrix4x4 &parentWorld);
+    void replicateDrawList();
+    void batchInstances();
+    void attachInstanceBuffer(const DrawItem &item, GLint location);
+    void sortDrawList(const QMatrix4x4 &viewProjection);
+    void cullDrawList(const QMatrix4x4 &viewProjection);
+    int selectLod(const DrawItem &item, const QMatrix4x4 &viewProjection) const;
+    void drawModel();
+    bool isOcclusionActive() const;
+    bool createOcclusionResources();
+    void removeOcclusionResources();
+    void readOcclusionQueries();
+    void drawOcclusionBoxes(const QMatrix4x4 &viewProjection);
+    bool setNewSettings();
+    void removeSettings();
+    void removeBuffers();
+    void removePrograms();
+    void removeTextures();
+    void removeTextureCache();
+    void removeUniformTimers();
+    void refreshProgramCopies();
+    void applyOpenGLSettings();
+    void markDirty(int flags);
+
+    GLint createQuery(const QString progName);
+    void testQuery();
+    void getQueryResults();
+    void removeQueries();
+    GLuint nextTimestampQuery();
+
+    void setMVP(const ProgramBindings &table, const QMatrix4x4 &mvp, const QMatrix4x4 &modelMatrix);
+    void testProjection();
+    void testView();
+
+    QMatrix4x4 calculateMultiplyMat4x4(const UniformVariable &variable, bool showErrors);
+    QMatrix3x3 calculateMultiplyMat3x3(const UniformVariable &variable, bool showErrors);
+    QMatrix2x2 calculateMultiplyMat2x2(const UniformVariable &variable, bool showErrors);
+
+    QVector4D calculateMultiplyVec4(const UniformVariable &variable, bool showErrors);
+    QVector3D calculateMultiplyVec3(const UniformVariable &variable, bool showErrors);
+    QVector2D calculateMultiplyVec2(const UniformVariable &variable, bool showErrors);
+
+    GLenum convertToGLEnum(SettingsStorage::BLEND_FUNCTION func) const;
+
+
+    template <typename T>
+    /**
+     * @brief calculateMultiplyInt Calculate multiply scalar size variable.
+     * @param variable Multiply variable mode.
+     * @param showErrors Print errors or warnings.
+     * @return Calculated variable.
+     */
+    T calculateMultiplyScalar(const UniformVariable &variable, bool showErrors)
+    {
+        if(!variable.isMultiplyMode())
+        {
+            if(showErrors)
+                log.addUniformError(tr("Error uniform variable %1 is not in multiply mode").arg(variable.getName()));
+
+            return 0;
+        }
+
+        UniformTypes::UNIFORM_TYPES type = variable.getScalarType();
+        QString name = variable.getName();
+        T result = 1;
+        MetaProject* proj = infoM->getActiveProject();
+
+        QList<QVariant> list = variable.getValues();
+
+        foreach(QVariant var, list)
+        {
+            UniformVariable* u = proj->getUniformVariable(var.toString());
+
+            if(!testMultiplyVar(name,var.toString(),u,showErrors))
+            {
+                return 0;
+            }
+
+            if(u->getUniformSize() != UniformTypes::SCALAR)
+            {
+                if(showErrors)
+                    log.addUniformError(tr("When computing multiply mode uniform variable %1, %2 is not Matrix 4x4!")
+                                        .arg(name, var.toString()));
+
+                return 0;
+            }
+
+            switch(type)
+            {
+            case UniformTypes::FLOAT:
+                result *= u->getValueFloat();
+                break;
+
+            case UniformTypes::INT:
+                result *= u->getValueInt();
+                break;
+
+            case UniformTypes::UINT:
+                result *= u->getValueUInt();
+                break;
+
+            default:
+                result *= u->getValueFloat();
+            }
+        }
+
+        return result;
+    }
+
+    bool testMultiplyVar(QString name, QString innerVar, UniformVariable *var, bool showErrors);
+
+private:
+    bool readShaderSource(const QString path, QByteArray &source);
+    bool prepareShaderProgram(const QString& vertexShaderPath, const QString& fragmentShaderPath);
+    InfoManager *infoM;
+    int viewportWidth;
+    int viewportHeight;
+    QMatrix4x4 view;
+    QMatrix4x4 projection;
+    QStack<QMatrix4x4> mvpStack;
+
+    QHash<QPair<Mesh*,QString>,GLuint> vertexArrays;
+    QVector<DrawItem> drawList;
+    QMatrix4x4 drawListSortMatrix;
+    bool isDrawListSorted;
+    int drawnCount;
+    int culledCount;
+    int lodOverride;
+
+    // occlusion culling, query of draw is indexed by its occlusionId
+    bool occlusionCulling;
+    int occludedCount;
+    QGLShaderProgram* occlusionProgram;
+    QGLBuffer occlusionBoxBuffer;
+    GLuint occlusionArray;
+    GLenum occlusionTarget;
+    QVector<GLuint> occlusionQueries;
+    QVector<bool> occlusionIssued;
+    QMatrix4x4 occlusionMatrix;
+
+    //int mvp_loc;
+    QHash<QString,QGLShaderProgram *> shaders;
+//    QHash<QString,QGLShaderProgram *> backupShaders;
+    QHash<QString,const MetaShaderProg*> programs;
+    QVector<ProgramBindings> programTables;
+    QHash<QString,int> programIds;
+    UniformBlock frameBlock;
+    UniformBlock objectBlock;
+    UniformBlock sharedBlock;
+    ProgramBinaryCache programCache;
+    QVector<PendingProgram> pendingPrograms;
+    QHash<QString,ShaderObject> shaderObjects;
+    QSet<QString> usedShaderObjects;
+    QHash<QString,QGLShaderProgram*> reusableShaders;
+    QHash<QString,QByteArray> programKeys;
+    QElapsedTimer compileTime;
+    bool parallelCompile;
+    bool restartCompile;
+    bool uniformsReset;
+    int objectStride;
+    QHash<QString,UniformVariable*> sharedVariables;
+    QHash<QString,quint64> sharedVersions;
+    QMatrix4x4 frameProjection;
+    QMatrix4x4 frameView;
+    QElapsedTimer frameTime;
+    QGLBuffer modelVertexBuffer;
+    QGLBuffer modelIndexBuffer;
+    QGLBuffer instanceBuffer;
+    QString logReport;
+    ModelNode* rootNode;
+    QHash<QString,GLTexture*> textures;
+    QHash<QString,GLTexture*> textureCache;
+    QList<GLTexture*> decodingTextures;
+    TextureUploader textureUploader;
+    bool canRender;
+    bool showErrors;
+    int dirtyFlags;
+    bool updatePending;
+    bool isDrawPaused;
+
+    //bool rotate[4];
+    //bool zoom[2];
+
+    // for logging information
+    LogEditor log;
+
+    // for time measurement
+    //QTimer* measureTimer;
+    //GLuint timeQuery;
+    //bool isQuerySet;
+
+    QHash<QString,TimeQueryStorage*> profiles;
+    DrawTimestamps drawTimestamps;
+    bool drawTiming;
+    QList<DataTimer*> uniformTimers;
+    QList<UniformVariable*> timeUniforms;
+    QList<UniformVariable*> pressedUniforms;
+
+    bool buttonPressedField[15];
+    bool testingVar;
+
+signals:
+    //void newMeasure(double time);
+    void queryCreated(const QString progName);
+    void queryDestroyed(const QString progName);
+    void updateRequested();
+    void cameraReset();
+    
+private slots:
+    void pendingUpdate();
+    void textureDecoded();
+    void incUnifTimeTimers(long id);
+    void incUnifActionPressedTimers(long id);
+
+public slots:
+    //void loadActiveShaders();
+    void runShaders();
+    void loadNewModel();
+    void reloadShaderPrograms();
+    void newTextures();
+    void newUniformValues();
+
+    void pauseDrawing(bool pause);
+
+    void setOpenGLSettings();
+
+};
+
+#endif // RENDERCORE_H
@@ -1,12 +1,21 @@
 #include "gltexture.h"
+#include "texture/textureencoder.h"
 #include <QGLWidget>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QtConcurrentRun>
+#include <cstring>
 
 /**
  * @brief GLTexture::GLTexture Create OpenGL texture and communicate with it through this object.
  * @param texture Texture storage with information needed for texture creating.
  */
 GLTexture::GLTexture(const TextureStorage *texture) :
-    texture(texture)
+    texture(texture),
+    decoder(NULL),
+    texId(0),
+    uploadId(0),
+    uploadFence(0)
 {
     convertEnums();
 }
@@ -16,12 +25,24 @@ GLTexture::GLTexture(const TextureStorage *texture) :
  */
 GLTexture::~GLTexture()
 {
-    glDeleteTextures(1, &texId);
+    // running decoding only finishes in worker thread, it does not use this object
+    delete decoder;
+
+    if(uploadFence != 0)
+        glDeleteSync(uploadFence);
+
+    if(uploadId != 0)
+        glDeleteTextures(1, &uploadId);
+
+    if(texId != 0)
+        glDeleteTextures(1, &texId);
+
     delete texture;
 }
 
 /**
- * @brief GLTexture::createOGLTexture Create OpenGL texture.
+ * @brief GLTexture::createOGLTexture Create OpenGL texture with placeholder image. Image is decoded by startDecoding
+ * in worker thread and streamed to new texture by uploadDecodedImage.
  * @return True if texture is created good, false otherwise.
  */
 bool GLTexture::createOGLTexture()
@@ -38,22 +59,14 @@ bool GLTexture::createOGLTexture()
 
     */
 
-    QImage image = QGLWidget::convertToGLFormat(texture->getImage());
+    // grey texel is drawn until image is decoded
+    const GLubyte placeholder[4] = {128, 128, 128, 255};
 
-    switch(target)
+    if(!uploadImage(1, 1, placeholder))
     {
-    case GL_TEXTURE_2D:
-        glTexImage2D(target, 0, GL_RGBA, image.width(), image.height(),
-                     0, GL_RGBA, GL_UNSIGNED_BYTE, image.bits());
-        break;
-    case GL_TEXTURE_1D:
-        glTexImage1D(target, 0, GL_RGBA, image.width(), 0, GL_RGBA,
-                     GL_UNSIGNED_BYTE, image.bits());
-        break;
-    default:
         glDeleteTextures(1, &texId);
+        texId = 0;
         return false;
-        break;
     }
 
     glTexParameteri(target, GL_TEXTURE_MIN_FILTER, minFilter);
@@ -67,6 +80,393 @@ bool GLTexture::createOGLTexture()
     return true;
 }
 
+/**
+ * @brief GLTexture::startDecoding Start loading and converting of image in thread pool.
+ * @param cacheDir Directory with images encoded to compressed formats.
+ * @param receiver Object notified when image is decoded, can be NULL.
+ * @param member Slot of receiver called when image is decoded.
+ */
+void GLTexture::startDecoding(const QString cacheDir, QObject *receiver, const char *member)
+{
+    delete decoder;
+    decoder = new QFutureWatcher<DecodedImage>();
+
+    if(receiver != NULL)
+        QObject::connect(decoder, SIGNAL(finished()), receiver, member);
+
+    decoder->setFuture(QtConcurrent::run(&GLTexture::decodeImage, texture->getPath(), texture->getType(),
+                                         texture->getCompression(), texture->isMipMap(), cacheDir));
+}
+
+/**
+ * @brief GLTexture::isDecoded Test if image is decoded and waits for upload.
+ * @return True if image can be uploaded without waiting, false otherwise.
+ */
+bool GLTexture::isDecoded() const
+{
+    return decoder != NULL && decoder->isFinished();
+}
+
+/**
+ * @brief GLTexture::uploadDecodedImage Start upload of decoded image to new texture with storage for full mipmap
+ * chain. Image is streamed through pixel buffer object, placeholder is used until finishUpload replaces it.
+ * OpenGL context must be current.
+ * @param uploader Streaming uploader of images.
+ * @return True if upload was started, false if image canno't be loaded.
+ */
+bool GLTexture::uploadDecodedImage(TextureUploader &uploader)
+{
+    if(!isDecoded())
+        return false;
+
+    DecodedImage decoded = decoder->result();
+
+    delete decoder;
+    decoder = NULL;
+
+    if(!decoded.compressed.isNull())
+        return uploadCompressedImage(decoded.compressed);
+
+    const QImage& image = decoded.image;
+
+    if(image.isNull())
+        return false;
+
+    int layers = TextureStorage::getLayerCount(texture->getType(), image.width(), image.height());
+
+    if(layers == 0)
+        return false;
+
+    int width = image.width();
+    int height = image.height() / layers;
+    int depth = (target == GL_TEXTURE_3D) ? layers : 1;
+    int levels = texture->isMipMap() ? TextureUploader::getMipmapLevels(width, height, depth) : 1;
+
+    glGenTextures(1, &uploadId);
+    glBindTexture(target, uploadId);
+
+    if(!createStorage(levels, width, height, layers) || !uploader.upload(target, uploadId, image, layers))
+    {
+        glBindTexture(target, 0);
+        glDeleteTextures(1, &uploadId);
+        uploadId = 0;
+        return false;
+    }
+
+    glBindTexture(target, uploadId);
+
+    setParameters(levels);
+
+    if(texture->isMipMap())
+        glGenerateMipmap(target);
+
+    glBindTexture(target, 0);
+
+    // texture is ready when driver finishes copy and mipmaps
+    uploadFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    return true;
+}
+
+/**
+ * @brief GLTexture::uploadCompressedImage Upload precompressed mipmap chain to new texture, mipmaps are not
+ * generated, only levels stored in file are used. OpenGL context must be current.
+ * @param image Compressed image loaded from KTX or DDS file.
+ * @return True if upload was started, false if format or target of texture is not supported.
+ */
+bool GLTexture::uploadCompressedImage(const CompressedImage &image)
+{
+    GLenum format = image.getInternalFormat();
+
+    if(target != GL_TEXTURE_2D || !isCompressedFormatSupported(format))
+        return false;
+
+    glGenTextures(1, &uploadId);
+    glBindTexture(target, uploadId);
+
+    for(int level = 0; level < image.getLevelCount(); ++level)
+    {
+        QSize size = image.getLevelSize(level);
+        const QByteArray& data = image.getLevel(level);
+
+        glCompressedTexImage2D(target, level, format, size.width(), size.height(), 0, data.size(), data.constData());
+    }
+
+    setParameters(image.getLevelCount());
+
+    glBindTexture(target, 0);
+
+    uploadFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    return true;
+}
+
+/**
+ * @brief GLTexture::isCompressedFormatSupported Test if OpenGL driver can sample block compressed format.
+ * @param format OpenGL internal format.
+ * @return True if format is supported, false otherwise.
+ */
+bool GLTexture::isCompressedFormatSupported(GLenum format)
+{
+    switch(format)
+    {
+    case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+    case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+        return GLEW_EXT_texture_compression_s3tc;
+    case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT:
+    case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+        return GLEW_EXT_texture_compression_s3tc && GLEW_EXT_texture_sRGB;
+    case GL_COMPRESSED_RED_RGTC1:
+    case GL_COMPRESSED_SIGNED_RED_RGTC1:
+    case GL_COMPRESSED_RG_RGTC2:
+    case GL_COMPRESSED_SIGNED_RG_RGTC2:
+        return GLEW_VERSION_3_0 || GLEW_ARB_texture_compression_rgtc;
+    case GL_COMPRESSED_RGBA_BPTC_UNORM:
+    case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM:
+    case GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT:
+    case GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT:
+        return GLEW_VERSION_4_2 || GLEW_ARB_texture_compression_bptc;
+    }
+
+    return false;
+}
+
+/**
+ * @brief GLTexture::setParameters Set filters, wraps and number of mipmap levels of bound texture.
+ * @param levels Number of mipmap levels in texture.
+ */
+void GLTexture::setParameters(int levels)
+{
+    glTexParameteri(target, GL_TEXTURE_MIN_FILTER, minFilter);
+    glTexParameteri(target, GL_TEXTURE_MAG_FILTER, magFilter);
+    glTexParameteri(target, GL_TEXTURE_WRAP_S, clampS);
+    glTexParameteri(target, GL_TEXTURE_WRAP_R, clampR);
+    glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, levels - 1);
+}
+
+/**
+ * @brief GLTexture::isUploading Test if uploaded texture waits for its fence.
+ * @return True if upload is running, false otherwise.
+ */
+bool GLTexture::isUploading() const
+{
+    return uploadFence != 0;
+}
+
+/**
+ * @brief GLTexture::finishUpload Test fence of upload without waiting, when upload is finished placeholder
+ * is replaced by uploaded texture.
+ * @return True if texture was replaced, false if upload is still running or there is no upload.
+ */
+bool GLTexture::finishUpload()
+{
+    if(uploadFence == 0)
+        return false;
+
+    GLenum status = glClientWaitSync(uploadFence, 0, 0);
+
+    if(status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+        return false;
+
+    glDeleteSync(uploadFence);
+    uploadFence = 0;
+
+    if(texId != 0)
+        glDeleteTextures(1, &texId);
+
+    texId = uploadId;
+    uploadId = 0;
+
+    return true;
+}
+
+/**
+ * @brief GLTexture::createStorage Create storage for all mipmap levels of bound texture. Immutable storage is used
+ * when it is supported.
+ * @param levels Number of mipmap levels.
+ * @param width Width of base level.
+ * @param height Height of base level, ignored for 1D texture.
+ * @param layers Depth of 3D texture or number of layers of texture array, ignored for other textures.
+ * @return True if target of texture is supported, false otherwise.
+ */
+bool GLTexture::createStorage(int levels, int width, int height, int layers)
+{
+    if(TextureUploader::isStorageSupported())
+    {
+        switch(target)
+        {
+        case GL_TEXTURE_2D:
+        case GL_TEXTURE_CUBE_MAP:
+            glTexStorage2D(target, levels, GL_RGBA8, width, height);
+            return true;
+        case GL_TEXTURE_1D:
+            glTexStorage1D(target, levels, GL_RGBA8, width);
+            return true;
+        case GL_TEXTURE_3D:
+        case GL_TEXTURE_2D_ARRAY:
+            glTexStorage3D(target, levels, GL_RGBA8, width, height, layers);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    for(int level = 0; level < levels; ++level)
+    {
+        switch(target)
+        {
+        case GL_TEXTURE_2D:
+            glTexImage2D(target, level, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+            break;
+        case GL_TEXTURE_1D:
+            glTexImage1D(target, level, GL_RGBA8, width, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+            break;
+        case GL_TEXTURE_3D:
+        case GL_TEXTURE_2D_ARRAY:
+            glTexImage3D(target, level, GL_RGBA8, width, height, layers, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+            break;
+        case GL_TEXTURE_CUBE_MAP:
+            for(int face = 0; face < 6; ++face)
+            {
+                glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, level, GL_RGBA8, width, height, 0,
+                             GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+            }
+            break;
+        default:
+            return false;
+        }
+
+        width = qMax(width / 2, 1);
+        height = qMax(height / 2, 1);
+
+        // layers of array are not reduced
+        if(target == GL_TEXTURE_3D)
+            layers = qMax(layers / 2, 1);
+    }
+
+    return true;
+}
+
+/**
+ * @brief GLTexture::getName Get name of texture.
+ * @return Name of texture storage.
+ */
+QString GLTexture::getName() const
+{
+    return texture->getName();
+}
+
+/**
+ * @brief GLTexture::decodeImage Load image from file and convert it to OpenGL format, KTX and DDS files are
+ * loaded as compressed image and other 2D images are encoded when compression is set. Called in worker thread.
+ * @param path Path to image file.
+ * @param type Texture type, layers and faces are reordered for upload.
+ * @param compression Format of compressed texture.
+ * @param mipmaps True if mipmaps of compressed texture are encoded too.
+ * @param cacheDir Directory with images encoded to compressed formats.
+ * @return Decoded image, both images are null if file canno't be loaded.
+ */
+GLTexture::DecodedImage GLTexture::decodeImage(const QString path, TextureStorage::TexType type,
+                                               TextureStorage::TexCompression compression, bool mipmaps,
+                                               const QString cacheDir)
+{
+    DecodedImage decoded;
+
+    if(CompressedImage::isCompressedFile(path))
+    {
+        decoded.compressed.load(path);
+        return decoded;
+    }
+
+    if(compression != TextureStorage::NO_COMPRESSION && type == TextureStorage::TEXTURE_2D)
+    {
+        decoded.compressed = TextureEncoder::encodeCached(path, compression, mipmaps, cacheDir);
+        return decoded;
+    }
+
+    decoded.image = QImage(path);
+
+    if(decoded.image.isNull())
+        return decoded;
+
+    decoded.image = QGLWidget::convertToGLFormat(decoded.image);
+
+    int layers = TextureStorage::getLayerCount(type, decoded.image.width(), decoded.image.height());
+
+    // conversion flips whole image, so layers are in reversed order and faces of cube map upside down
+    if(type == TextureStorage::TEXTURE_CUBE_MAP)
+        decoded.image = decoded.image.mirrored();
+    else if(layers > 1)
+        decoded.image = reverseLayers(decoded.image, layers);
+
+    return decoded;
+}
+
+/**
+ * @brief GLTexture::reverseLayers Reverse order of square tiles in image, rows of tiles are kept.
+ * @param image Image with layers stacked from top to bottom.
+ * @param layers Number of layers.
+ * @return Image with reversed layers.
+ */
+QImage GLTexture::reverseLayers(const QImage &image, int layers)
+{
+    QImage reversed(image.size(), image.format());
+    int layerHeight = image.height() / layers;
+    int lineSize = qMin(image.bytesPerLine(), reversed.bytesPerLine());
+
+    for(int layer = 0; layer < layers; ++layer)
+    {
+        int source = (layers - 1 - layer) * layerHeight;
+
+        for(int y = 0; y < layerHeight; ++y)
+            memcpy(reversed.scanLine(layer * layerHeight + y), image.constScanLine(source + y), lineSize);
+    }
+
+    return reversed;
+}
+
+/**
+ * @brief GLTexture::uploadImage Upload RGBA data from client memory to bound texture, used for placeholder.
+ * @param width Width of image.
+ * @param height Height of image, ignored for 1D texture.
+ * @param data Image data.
+ * @return True if target of texture is supported, false otherwise.
+ */
+bool GLTexture::uploadImage(int width, int height, const GLvoid *data)
+{
+    switch(target)
+    {
+    case GL_TEXTURE_3D:
+    case GL_TEXTURE_2D_ARRAY:
+        glTexImage3D(target, 0, GL_RGBA, width, height, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+        break;
+    case GL_TEXTURE_CUBE_MAP:
+        for(int face = 0; face < 6; ++face)
+        {
+            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, GL_RGBA, width, height,
+                         0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+        }
+        break;
+    case GL_TEXTURE_2D:
+        glTexImage2D(target, 0, GL_RGBA, width, height,
+                     0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+        break;
+    case GL_TEXTURE_1D:
+        glTexImage1D(target, 0, GL_RGBA, width, 0, GL_RGBA,
+                     GL_UNSIGNED_BYTE, data);
+        break;
+    default:
+        return false;
+        break;
+    }
+
+    return true;
+}
+
 /**
  * @brief GLTexture::useTexture Activate texture on given texture unit.
  * @param uniformLocation Location of texture sampler in shader.
@@ -88,6 +488,96 @@ bool GLTexture::useTexture(int uniformLocation, int texUnit)
     return false;
 }
 
+/**
+ * @brief GLTexture::bindTexture Bind texture to given texture unit. Sampler uniform must be set by caller.
+ * @param texUnit OpenGL texture unit, where we want attach this texture.
+ * @return Return true if texture unit is in implementation dependand bounds (minimum 80), false otherwise.
+ */
+bool GLTexture::bindTexture(int texUnit)
+{
+    if(texUnit >= 0 && texUnit < GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS)
+    {
+        glActiveTexture(GL_TEXTURE0 + texUnit);
+        glBindTexture(target, texId);
+
+        glActiveTexture(GL_TEXTURE0);
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief GLTexture::isSamplerCompatible Test if texture can be sampled by sampler of given type.
+ * @param samplerType OpenGL type of sampler uniform.
+ * @return True if sampler samples target of this texture, false otherwise.
+ */
+bool GLTexture::isSamplerCompatible(GLenum samplerType) const
+{
+    return getSamplerTarget(samplerType) == target;
+}
+
+/**
+ * @brief GLTexture::getSamplerTarget Get texture target sampled by sampler type.
+ * @param samplerType OpenGL type of sampler uniform.
+ * @return OpenGL texture target, 0 for unsupported sampler.
+ */
+GLenum GLTexture::getSamplerTarget(GLenum samplerType)
+{
+    switch(samplerType)
+    {
+    case GL_SAMPLER_1D:
+    case GL_SAMPLER_1D_SHADOW:
+    case GL_INT_SAMPLER_1D:
+    case GL_UNSIGNED_INT_SAMPLER_1D:
+        return GL_TEXTURE_1D;
+    case GL_SAMPLER_2D:
+    case GL_SAMPLER_2D_SHADOW:
+    case GL_INT_SAMPLER_2D:
+    case GL_UNSIGNED_INT_SAMPLER_2D:
+        return GL_TEXTURE_2D;
+    case GL_SAMPLER_3D:
+    case GL_INT_SAMPLER_3D:
+    case GL_UNSIGNED_INT_SAMPLER_3D:
+        return GL_TEXTURE_3D;
+    case GL_SAMPLER_2D_ARRAY:
+    case GL_SAMPLER_2D_ARRAY_SHADOW:
+    case GL_INT_SAMPLER_2D_ARRAY:
+    case GL_UNSIGNED_INT_SAMPLER_2D_ARRAY:
+        return GL_TEXTURE_2D_ARRAY;
+    case GL_SAMPLER_CUBE:
+    case GL_SAMPLER_CUBE_SHADOW:
+    case GL_INT_SAMPLER_CUBE:
+    case GL_UNSIGNED_INT_SAMPLER_CUBE:
+        return GL_TEXTURE_CUBE_MAP;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief GLTexture::createCacheKey Create key of OpenGL texture created from texture storage. Key contains path
+ * and modification time of image file and all parameters of texture, so changed texture gets new key.
+ * @param texture Texture storage with information needed for texture creating.
+ * @return Key of OpenGL texture.
+ */
+QString GLTexture::createCacheKey(const TextureStorage *texture)
+{
+    QFileInfo info(texture->getPath());
+
+    return QString("%1|%2|%3|%4|%5|%6|%7|%8|%9|%10")
+            .arg(info.absoluteFilePath())
+            .arg(info.lastModified().toMSecsSinceEpoch())
+            .arg(texture->getType())
+            .arg(texture->getMinFilter())
+            .arg(texture->getMagFilter())
+            .arg(texture->getSWrap())
+            .arg(texture->getRWrap())
+            .arg(texture->isMipMap())
+            .arg(texture->getMipMapLevel())
+            .arg(texture->getCompression());
+}
+
 /**
  * @brief GLTexture::convertEnums Convert all TextureStorage enums to OpenGL enums.
  */
@@ -115,6 +605,15 @@ GLenum GLTexture::convertTypeToGL(const TextureStorage::TexType type)
     case TextureStorage::TEXTURE_2D:
         return GL_TEXTURE_2D;
         break;
+    case TextureStorage::TEXTURE_3D:
+        return GL_TEXTURE_3D;
+        break;
+    case TextureStorage::TEXTURE_2D_ARRAY:
+        return GL_TEXTURE_2D_ARRAY;
+        break;
+    case TextureStorage::TEXTURE_CUBE_MAP:
+        return GL_TEXTURE_CUBE_MAP;
+        break;
     }
 
     return 0;
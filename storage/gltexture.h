@@ -2,8 +2,12 @@
 #define GLTEXTURE_H
 
 #include "texture/texturestorage.h"
+#include "texture/compressedimage.h"
+#include "storage/textureuploader.h"
 #define GLEW_STATIC
 #include <GL/glew.h>
+#include <QFutureWatcher>
+#include <QImage>
 
 class GLTexture
 {
@@ -12,9 +16,36 @@ public:
     ~GLTexture();
 
     bool createOGLTexture();
+    void startDecoding(const QString cacheDir, QObject *receiver = NULL, const char *member = NULL);
+    bool isDecoded() const;
+    bool uploadDecodedImage(TextureUploader &uploader);
+    bool isUploading() const;
+    bool finishUpload();
+    QString getName() const;
     bool useTexture(int uniformLocation, int texUnit = 0);
+    bool bindTexture(int texUnit);
+    bool isSamplerCompatible(GLenum samplerType) const;
+
+    static QString createCacheKey(const TextureStorage *texture);
+    static bool isCompressedFormatSupported(GLenum format);
 
 private:
+    /**
+     * @brief The DecodedImage struct Result of decoding, compressed image is filled for KTX and DDS files.
+     */
+    struct DecodedImage {
+        QImage image;
+        CompressedImage compressed;
+    };
+
+    static DecodedImage decodeImage(const QString path, TextureStorage::TexType type,
+                                    TextureStorage::TexCompression compression, bool mipmaps, const QString cacheDir);
+    static QImage reverseLayers(const QImage &image, int layers);
+    static GLenum getSamplerTarget(GLenum samplerType);
+    bool uploadImage(int width, int height, const GLvoid *data);
+    bool uploadCompressedImage(const CompressedImage &image);
+    bool createStorage(int levels, int width, int height, int layers);
+    void setParameters(int levels);
     void convertEnums();
     GLenum convertTypeToGL(const TextureStorage::TexType type);
     GLenum convertFilterToGL(const TextureStorage::TexFilter filter);
@@ -22,7 +53,10 @@ private:
 
 private:
     const TextureStorage* texture;
+    QFutureWatcher<DecodedImage>* decoder;
     GLuint texId;
+    GLuint uploadId;
+    GLsync uploadFence;
     GLenum target;
     GLenum minFilter;
     GLenum magFilter;
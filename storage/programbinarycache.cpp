@@ -0,0 +1,201 @@
+#include "programbinarycache.h"
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QFile>
+#include <QDir>
+
+/**
+ * @brief ProgramBinaryCache::ProgramBinaryCache Create cache, support of program binaries is tested by initialize.
+ */
+ProgramBinaryCache::ProgramBinaryCache() :
+    supported(false)
+{
+}
+
+/**
+ * @brief ProgramBinaryCache::initialize Test if OpenGL driver can return program binaries and remember driver
+ * identification for cache keys. OpenGL context must be current.
+ * @return True if program binaries are supported, false otherwise.
+ */
+bool ProgramBinaryCache::initialize()
+{
+    supported = false;
+    driver.clear();
+
+    if(!GLEW_ARB_get_program_binary && !GLEW_VERSION_4_1)
+        return false;
+
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+
+    if(formats <= 0)
+        return false;
+
+    driver.append(reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
+    driver.append('\n');
+    driver.append(reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+    driver.append('\n');
+    driver.append(reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+
+    supported = true;
+
+    return true;
+}
+
+/**
+ * @brief ProgramBinaryCache::isSupported Test if cache can be used.
+ * @return True if program binaries are supported and cache directory is set, false otherwise.
+ */
+bool ProgramBinaryCache::isSupported() const
+{
+    return supported && !directory.isEmpty();
+}
+
+/**
+ * @brief ProgramBinaryCache::setDirectory Set directory where binaries are stored, it is created with first binary.
+ * @param path Path to cache directory.
+ */
+void ProgramBinaryCache::setDirectory(const QString path)
+{
+    directory = path;
+}
+
+/**
+ * @brief ProgramBinaryCache::getDirectory Get directory where binaries are stored.
+ * @return Path to cache directory.
+ */
+QString ProgramBinaryCache::getDirectory() const
+{
+    return directory;
+}
+
+/**
+ * @brief ProgramBinaryCache::createKey Create key of shader program from its sources and OpenGL driver.
+ * @param vertexSource Source code of vertex shader.
+ * @param fragmentSource Source code of fragment shader.
+ * @return Hexadecimal hash used as key.
+ */
+QByteArray ProgramBinaryCache::createKey(const QByteArray &vertexSource, const QByteArray &fragmentSource) const
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+
+    hash.addData(vertexSource);
+    hash.addData("\n#fragment\n");
+    hash.addData(fragmentSource);
+    hash.addData("\n#driver\n");
+    hash.addData(driver);
+
+    return hash.result().toHex();
+}
+
+/**
+ * @brief ProgramBinaryCache::prepareProgram Ask driver to keep binary of shader program, must be called before link.
+ * @param programId OpenGL identifier of shader program.
+ */
+void ProgramBinaryCache::prepareProgram(GLuint programId) const
+{
+    if(supported)
+        glProgramParameteri(programId, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+}
+
+/**
+ * @brief ProgramBinaryCache::loadProgram Load stored binary to shader program. Driver can reject binary,
+ * for example after driver update, then binary is removed and shader program must be compiled from sources.
+ * @param programId OpenGL identifier of shader program without attached shaders.
+ * @param key Key of shader program.
+ * @return True if shader program is linked from stored binary, false otherwise.
+ */
+bool ProgramBinaryCache::loadProgram(GLuint programId, const QByteArray &key) const
+{
+    if(!isSupported())
+        return false;
+
+    QFile file(getFilePath(key));
+
+    if(!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_4_8);
+
+    quint32 format;
+    QByteArray binary;
+
+    in >> format;
+    in >> binary;
+
+    file.close();
+
+    if(in.status() != QDataStream::Ok || binary.isEmpty())
+        return false;
+
+    glProgramBinary(programId, format, binary.constData(), binary.size());
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(programId, GL_LINK_STATUS, &linked);
+
+    if(linked != GL_TRUE)
+    {
+        file.remove();
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief ProgramBinaryCache::saveProgram Store binary of linked shader program to cache directory.
+ * @param programId OpenGL identifier of linked shader program.
+ * @param key Key of shader program.
+ * @return True if binary is stored, false otherwise.
+ */
+bool ProgramBinaryCache::saveProgram(GLuint programId, const QByteArray &key) const
+{
+    if(!isSupported())
+        return false;
+
+    GLint length = 0;
+    glGetProgramiv(programId, GL_PROGRAM_BINARY_LENGTH, &length);
+
+    if(length <= 0)
+        return false;
+
+    QByteArray binary(length, 0);
+    GLenum format = 0;
+    GLsizei written = 0;
+
+    glGetProgramBinary(programId, length, &written, &format, binary.data());
+
+    if(written <= 0)
+        return false;
+
+    binary.resize(written);
+
+    if(!QDir().mkpath(directory))
+        return false;
+
+    QFile file(getFilePath(key));
+
+    if(!file.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_4_8);
+
+    out << static_cast<quint32>(format);
+    out << binary;
+
+    file.close();
+
+    return out.status() == QDataStream::Ok;
+}
+
+/**
+ * @brief ProgramBinaryCache::getFilePath Get path of file with binary of shader program.
+ * @param key Key of shader program.
+ * @return Path to file in cache directory.
+ */
+QString ProgramBinaryCache::getFilePath(const QByteArray &key) const
+{
+    return QDir(directory).filePath(QString::fromLatin1(key) + ".bin");
+}
@@ -0,0 +1,40 @@
+#ifndef PROGRAMBINARYCACHE_H
+#define PROGRAMBINARYCACHE_H
+
+#define GLEW_STATIC
+#include <GL/glew.h>
+#include <QString>
+#include <QByteArray>
+
+/**
+ * @brief The ProgramBinaryCache class Cache of linked shader programs on disk. Binaries are read by
+ * glGetProgramBinary and stored in cache directory under hash of shader sources and OpenGL driver,
+ * so binary is never loaded to other driver or after sources changed.
+ */
+class ProgramBinaryCache
+{
+public:
+    ProgramBinaryCache();
+
+    bool initialize();
+    bool isSupported() const;
+
+    void setDirectory(const QString path);
+    QString getDirectory() const;
+
+    QByteArray createKey(const QByteArray &vertexSource, const QByteArray &fragmentSource) const;
+
+    void prepareProgram(GLuint programId) const;
+    bool loadProgram(GLuint programId, const QByteArray &key) const;
+    bool saveProgram(GLuint programId, const QByteArray &key) const;
+
+private:
+    QString getFilePath(const QByteArray &key) const;
+
+private:
+    bool supported;
+    QByteArray driver;
+    QString directory;
+};
+
+#endif // PROGRAMBINARYCACHE_H
@@ -0,0 +1,239 @@
+#include "textureuploader.h"
+#include <cstring>
+
+/**
+ * @brief TextureUploader::TextureUploader Create uploader, pixel buffer objects are created by create method.
+ */
+TextureUploader::TextureUploader() :
+    nextSlot(0),
+    created(false)
+{
+    for(int i = 0; i < RING_SIZE; ++i)
+    {
+        slots[i].buffer = 0;
+        slots[i].fence = 0;
+        slots[i].size = 0;
+    }
+}
+
+/**
+ * @brief TextureUploader::~TextureUploader Delete pixel buffer objects.
+ */
+TextureUploader::~TextureUploader()
+{
+    destroy();
+}
+
+/**
+ * @brief TextureUploader::create Create ring of pixel buffer objects. Buffers get their memory with first upload.
+ * OpenGL context must be current.
+ * @return True if buffers are created, false otherwise.
+ */
+bool TextureUploader::create()
+{
+    if(created)
+        return true;
+
+    for(int i = 0; i < RING_SIZE; ++i)
+    {
+        glGenBuffers(1, &slots[i].buffer);
+
+        if(slots[i].buffer == 0)
+        {
+            destroy();
+            return false;
+        }
+    }
+
+    nextSlot = 0;
+    created = true;
+
+    return true;
+}
+
+/**
+ * @brief TextureUploader::destroy Delete pixel buffer objects and fences.
+ */
+void TextureUploader::destroy()
+{
+    for(int i = 0; i < RING_SIZE; ++i)
+    {
+        if(slots[i].fence != 0)
+            glDeleteSync(slots[i].fence);
+
+        if(slots[i].buffer != 0)
+            glDeleteBuffers(1, &slots[i].buffer);
+
+        slots[i].buffer = 0;
+        slots[i].fence = 0;
+        slots[i].size = 0;
+    }
+
+    created = false;
+}
+
+/**
+ * @brief TextureUploader::isCreated Test if ring of buffers exists.
+ * @return True if buffers are created, false otherwise.
+ */
+bool TextureUploader::isCreated() const
+{
+    return created;
+}
+
+/**
+ * @brief TextureUploader::isReady Test if next buffer of the ring is free, fence of its last upload is only polled.
+ * Uploads which are not ready must be tried again later, for example in next frame.
+ * @return True if upload can be issued without waiting, false otherwise.
+ */
+bool TextureUploader::isReady()
+{
+    if(!create())
+        return false;
+
+    return isSlotFree(slots[nextSlot]);
+}
+
+/**
+ * @brief TextureUploader::isSlotFree Test if driver finished reading from buffer of slot and delete its fence.
+ * @param slot Tested slot of the ring.
+ * @return True if buffer can be written, false otherwise.
+ */
+bool TextureUploader::isSlotFree(Slot &slot)
+{
+    if(slot.fence == 0)
+        return true;
+
+    GLenum status = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+
+    if(status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+        return false;
+
+    glDeleteSync(slot.fence);
+    slot.fence = 0;
+
+    return true;
+}
+
+/**
+ * @brief TextureUploader::upload Upload image in OpenGL format (RGBA bytes) to base level of texture.
+ * Texture must have storage for image size.
+ * @param target Target of texture, GL_TEXTURE_1D, GL_TEXTURE_2D, GL_TEXTURE_3D, GL_TEXTURE_2D_ARRAY
+ * or GL_TEXTURE_CUBE_MAP.
+ * @param texture OpenGL identifier of texture.
+ * @param image Uploaded image, for 1D texture only first row is used. Layers and faces follow each other in rows.
+ * @param layers Number of layers of 3D texture and texture array, 6 for cube map.
+ * @return True if upload was issued, false if buffer is not free (see isReady) or upload failed.
+ */
+bool TextureUploader::upload(GLenum target, GLuint texture, const QImage &image, int layers)
+{
+    if(!create())
+        return false;
+
+    const int height = (target == GL_TEXTURE_1D) ? 1 : image.height();
+    const int size = image.bytesPerLine() * height;
+
+    if(size <= 0 || layers <= 0)
+        return false;
+
+    const int layerHeight = height / layers;
+
+    Slot& slot = slots[nextSlot];
+
+    // buffer can be still read by previous upload, render thread never waits for it
+    if(!isSlotFree(slot))
+        return false;
+
+    nextSlot = (nextSlot + 1) % RING_SIZE;
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.buffer);
+
+    if(slot.size < size)
+    {
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, size, NULL, GL_STREAM_DRAW);
+        slot.size = size;
+    }
+
+    void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size,
+                                    GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+
+    if(mapped == NULL)
+    {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        return false;
+    }
+
+    std::memcpy(mapped, image.constBits(), size);
+
+    if(!glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER))
+    {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        return false;
+    }
+
+    glBindTexture(target, texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    switch(target)
+    {
+    case GL_TEXTURE_2D:
+        glTexSubImage2D(target, 0, 0, 0, image.width(), image.height(), GL_RGBA, GL_UNSIGNED_BYTE, 0);
+        break;
+    case GL_TEXTURE_1D:
+        glTexSubImage1D(target, 0, 0, image.width(), GL_RGBA, GL_UNSIGNED_BYTE, 0);
+        break;
+    case GL_TEXTURE_3D:
+    case GL_TEXTURE_2D_ARRAY:
+        glTexSubImage3D(target, 0, 0, 0, 0, image.width(), layerHeight, layers, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+        break;
+    case GL_TEXTURE_CUBE_MAP:
+        for(int face = 0; face < layers; ++face)
+        {
+            const GLintptr offset = static_cast<GLintptr>(face) * layerHeight * image.bytesPerLine();
+
+            glTexSubImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, 0, 0, image.width(), layerHeight,
+                            GL_RGBA, GL_UNSIGNED_BYTE, reinterpret_cast<const GLvoid*>(offset));
+        }
+        break;
+    default:
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        return false;
+        break;
+    }
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    return true;
+}
+
+/**
+ * @brief TextureUploader::isStorageSupported Test if immutable texture storage can be used.
+ * @return True if glTexStorage is supported, false otherwise.
+ */
+bool TextureUploader::isStorageSupported()
+{
+    return GLEW_ARB_texture_storage || GLEW_VERSION_4_2;
+}
+
+/**
+ * @brief TextureUploader::getMipmapLevels Get number of levels of full mipmap chain.
+ * @param width Width of base level.
+ * @param height Height of base level.
+ * @param depth Depth of base level of 3D texture, 1 for other textures.
+ * @return Number of mipmap levels including base level.
+ */
+int TextureUploader::getMipmapLevels(int width, int height, int depth)
+{
+    int size = qMax(qMax(width, height), depth);
+    int levels = 1;
+
+    while(size > 1)
+    {
+        size /= 2;
+        ++levels;
+    }
+
+    return levels;
+}
@@ -0,0 +1,48 @@
+#ifndef TEXTUREUPLOADER_H
+#define TEXTUREUPLOADER_H
+
+#define GLEW_STATIC
+#include <GL/glew.h>
+#include <QImage>
+
+/**
+ * @brief The TextureUploader class Streaming upload of images to textures through ring of pixel buffer objects.
+ * Image is copied to mapped buffer and texture is filled from this buffer, so copy to texture memory is done
+ * by driver without stalling of the render thread. Buffer is used again after its fence is signaled.
+ */
+class TextureUploader
+{
+public:
+    TextureUploader();
+    ~TextureUploader();
+
+    bool create();
+    void destroy();
+    bool isCreated() const;
+    bool isReady();
+
+    bool upload(GLenum target, GLuint texture, const QImage &image, int layers = 1);
+
+    static bool isStorageSupported();
+    static int getMipmapLevels(int width, int height, int depth = 1);
+
+private:
+    /**
+     * @brief The Slot struct Pixel buffer object of the ring and fence of the last upload from it.
+     */
+    struct Slot {
+        GLuint buffer;
+        GLsync fence;
+        int size;
+    };
+
+    enum {RING_SIZE = 3};
+
+    static bool isSlotFree(Slot &slot);
+
+    Slot slots[RING_SIZE];
+    int nextSlot;
+    bool created;
+};
+
+#endif // TEXTUREUPLOADER_H
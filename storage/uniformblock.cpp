@@ -0,0 +1,361 @@
+#include "uniformblock.h"
+#include <QVector>
+#include <cstring>
+
+/**
+ * @brief UniformBlock::UniformBlock Create uniform buffer object for uniform block. OpenGL buffer is created
+ * by create method.
+ * @param blockName Name of uniform block in shaders.
+ * @param bindingPoint Uniform buffer binding point used by this block.
+ */
+UniformBlock::UniformBlock(const QString blockName, GLuint bindingPoint) :
+    name(blockName),
+    binding(bindingPoint),
+    bufferId(0),
+    dirtyBegin(0),
+    dirtyEnd(0)
+{
+}
+
+/**
+ * @brief UniformBlock::~UniformBlock Delete OpenGL buffer.
+ */
+UniformBlock::~UniformBlock()
+{
+    destroy();
+}
+
+/**
+ * @brief UniformBlock::create Create OpenGL buffer with given size. If buffer exists with the same size
+ * nothing is done, otherwise buffer is created again. OpenGL context must be current.
+ * @param size Size of buffer in bytes.
+ * @return True if buffer is created, false otherwise.
+ */
+bool UniformBlock::create(int size)
+{
+    if(size <= 0)
+        return false;
+
+    if(bufferId != 0 && size == data.size())
+        return true;
+
+    destroy();
+
+    glGenBuffers(1, &bufferId);
+
+    if(bufferId == 0)
+        return false;
+
+    data.fill(0, size);
+
+    glBindBuffer(GL_UNIFORM_BUFFER, bufferId);
+    glBufferData(GL_UNIFORM_BUFFER, size, data.constData(), GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    dirtyBegin = 0;
+    dirtyEnd = 0;
+
+    return true;
+}
+
+/**
+ * @brief UniformBlock::destroy Delete OpenGL buffer and client copy of data. Layout is kept.
+ */
+void UniformBlock::destroy()
+{
+    if(bufferId != 0)
+        glDeleteBuffers(1, &bufferId);
+
+    bufferId = 0;
+    data.clear();
+    dirtyBegin = 0;
+    dirtyEnd = 0;
+}
+
+/**
+ * @brief UniformBlock::isCreated Test if OpenGL buffer exists.
+ * @return True if buffer is created, false otherwise.
+ */
+bool UniformBlock::isCreated() const
+{
+    return bufferId != 0;
+}
+
+/**
+ * @brief UniformBlock::attachProgram Connect uniform block of shader program to binding point of this object.
+ * @param programId OpenGL identifier of linked shader program.
+ * @return True if shader program uses this uniform block, false otherwise.
+ */
+bool UniformBlock::attachProgram(GLuint programId) const
+{
+    GLuint index = glGetUniformBlockIndex(programId, name.toLatin1().constData());
+
+    if(index == GL_INVALID_INDEX)
+        return false;
+
+    glUniformBlockBinding(programId, index, binding);
+
+    return true;
+}
+
+/**
+ * @brief UniformBlock::readLayout Read layout of block members from shader program. Layout is read only once,
+ * other shader programs must declare block with the same size.
+ * @param programId OpenGL identifier of linked shader program.
+ * @return True if shader program declares block compatible with stored layout, false otherwise.
+ */
+bool UniformBlock::readLayout(GLuint programId)
+{
+    GLuint index = glGetUniformBlockIndex(programId, name.toLatin1().constData());
+
+    if(index == GL_INVALID_INDEX)
+        return false;
+
+    GLint size = 0;
+    glGetActiveUniformBlockiv(programId, index, GL_UNIFORM_BLOCK_DATA_SIZE, &size);
+
+    if(!members.isEmpty())
+        return size == data.size();
+
+    GLint count = 0;
+    glGetActiveUniformBlockiv(programId, index, GL_UNIFORM_BLOCK_ACTIVE_UNIFORMS, &count);
+
+    if(count <= 0)
+        return false;
+
+    QVector<GLint> indices(count);
+    glGetActiveUniformBlockiv(programId, index, GL_UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES, indices.data());
+
+    QVector<GLuint> uniforms(count);
+    QVector<GLint> offsets(count);
+    QVector<GLint> arrayStrides(count);
+    QVector<GLint> matrixStrides(count);
+    QVector<GLint> arraySizes(count);
+
+    for(int i = 0; i < count; ++i)
+        uniforms[i] = static_cast<GLuint>(indices.at(i));
+
+    glGetActiveUniformsiv(programId, count, uniforms.constData(), GL_UNIFORM_OFFSET, offsets.data());
+    glGetActiveUniformsiv(programId, count, uniforms.constData(), GL_UNIFORM_ARRAY_STRIDE, arrayStrides.data());
+    glGetActiveUniformsiv(programId, count, uniforms.constData(), GL_UNIFORM_MATRIX_STRIDE, matrixStrides.data());
+    glGetActiveUniformsiv(programId, count, uniforms.constData(), GL_UNIFORM_SIZE, arraySizes.data());
+
+    for(int i = 0; i < count; ++i)
+    {
+        GLchar memberName[256];
+        GLsizei length = 0;
+        glGetActiveUniformName(programId, uniforms.at(i), sizeof(memberName), &length, memberName);
+
+        // array members are named with first index
+        QString member = QString::fromLatin1(memberName, length);
+        int bracket = member.indexOf('[');
+
+        if(bracket >= 0)
+            member.truncate(bracket);
+
+        Member layout;
+        layout.offset = offsets.at(i);
+        layout.arrayStride = arrayStrides.at(i);
+        layout.matrixStride = matrixStrides.at(i);
+        layout.arraySize = arraySizes.at(i);
+
+        members.insert(member, layout);
+    }
+
+    return create(size);
+}
+
+/**
+ * @brief UniformBlock::clearLayout Remove layout of block members and delete OpenGL buffer.
+ */
+void UniformBlock::clearLayout()
+{
+    members.clear();
+    destroy();
+}
+
+/**
+ * @brief UniformBlock::hasMember Test if block has member with given name.
+ * @param name Name of block member.
+ * @return True if member exists in layout, false otherwise.
+ */
+bool UniformBlock::hasMember(const QString name) const
+{
+    return members.contains(name);
+}
+
+/**
+ * @brief UniformBlock::getMember Get layout of block member.
+ * @param name Name of block member.
+ * @return Layout of member.
+ */
+UniformBlock::Member UniformBlock::getMember(const QString name) const
+{
+    return members.value(name);
+}
+
+/**
+ * @brief UniformBlock::getMemberNames Get names of all block members.
+ * @return List of member names.
+ */
+QStringList UniformBlock::getMemberNames() const
+{
+    return members.keys();
+}
+
+/**
+ * @brief UniformBlock::getName Get name of uniform block in shaders.
+ * @return Name of uniform block.
+ */
+QString UniformBlock::getName() const
+{
+    return name;
+}
+
+/**
+ * @brief UniformBlock::getBindingPoint Get uniform buffer binding point of this block.
+ * @return Binding point.
+ */
+GLuint UniformBlock::getBindingPoint() const
+{
+    return binding;
+}
+
+/**
+ * @brief UniformBlock::getSize Get size of buffer.
+ * @return Size of buffer in bytes.
+ */
+int UniformBlock::getSize() const
+{
+    return data.size();
+}
+
+/**
+ * @brief UniformBlock::setData Write data to client copy of buffer. Data outside of buffer are ignored.
+ * @param offset Offset in buffer in bytes.
+ * @param data Written data.
+ * @param size Size of data in bytes.
+ */
+void UniformBlock::setData(int offset, const void *data, int size)
+{
+    if(offset < 0 || size <= 0 || offset + size > this->data.size())
+        return;
+
+    char* dest = this->data.data() + offset;
+
+    if(std::memcmp(dest, data, size) == 0)
+        return;
+
+    std::memcpy(dest, data, size);
+
+    if(dirtyBegin == dirtyEnd)
+    {
+        dirtyBegin = offset;
+        dirtyEnd = offset + size;
+    }
+    else
+    {
+        dirtyBegin = qMin(dirtyBegin, offset);
+        dirtyEnd = qMax(dirtyEnd, offset + size);
+    }
+}
+
+/**
+ * @brief UniformBlock::setFloats Write floats to client copy of buffer.
+ * @param offset Offset in buffer in bytes.
+ * @param data Written floats.
+ * @param count Number of floats.
+ */
+void UniformBlock::setFloats(int offset, const float *data, int count)
+{
+    setData(offset, data, count * sizeof(float));
+}
+
+/**
+ * @brief UniformBlock::setMatrix Write column major matrix to client copy of buffer. Every column
+ * starts on matrix stride.
+ * @param offset Offset in buffer in bytes.
+ * @param data Matrix values in column major order.
+ * @param columns Number of matrix columns.
+ * @param rows Number of matrix rows.
+ * @param matrixStride Distance between columns in bytes.
+ */
+void UniformBlock::setMatrix(int offset, const float *data, int columns, int rows, int matrixStride)
+{
+    for(int i = 0; i < columns; ++i)
+    {
+        setFloats(offset + i * matrixStride, data + i * rows, rows);
+    }
+}
+
+/**
+ * @brief UniformBlock::setMatrix Write matrix 4x4 with std140 layout to client copy of buffer.
+ * @param offset Offset in buffer in bytes.
+ * @param matrix Written matrix.
+ */
+void UniformBlock::setMatrix(int offset, const QMatrix4x4 &matrix)
+{
+    setMatrix(offset, matrix.constData(), 4, 4, 4 * sizeof(float));
+}
+
+/**
+ * @brief UniformBlock::setMatrix Write matrix 3x3 with std140 layout to client copy of buffer,
+ * columns are aligned as vec4.
+ * @param offset Offset in buffer in bytes.
+ * @param matrix Written matrix.
+ */
+void UniformBlock::setMatrix(int offset, const QMatrix3x3 &matrix)
+{
+    setMatrix(offset, matrix.constData(), 3, 3, 4 * sizeof(float));
+}
+
+/**
+ * @brief UniformBlock::upload Upload changed part of client copy to OpenGL buffer.
+ */
+void UniformBlock::upload()
+{
+    if(bufferId == 0 || dirtyBegin == dirtyEnd)
+        return;
+
+    glBindBuffer(GL_UNIFORM_BUFFER, bufferId);
+    glBufferSubData(GL_UNIFORM_BUFFER, dirtyBegin, dirtyEnd - dirtyBegin, data.constData() + dirtyBegin);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    dirtyBegin = 0;
+    dirtyEnd = 0;
+}
+
+/**
+ * @brief UniformBlock::bindBase Bind whole buffer to binding point of this block.
+ */
+void UniformBlock::bindBase() const
+{
+    if(bufferId != 0)
+        glBindBufferBase(GL_UNIFORM_BUFFER, binding, bufferId);
+}
+
+/**
+ * @brief UniformBlock::bindRange Bind part of buffer to binding point of this block.
+ * @param offset Offset in buffer in bytes, must be multiple of offset alignment.
+ * @param size Size of bound range in bytes.
+ */
+void UniformBlock::bindRange(int offset, int size) const
+{
+    if(bufferId != 0)
+        glBindBufferRange(GL_UNIFORM_BUFFER, binding, bufferId, offset, size);
+}
+
+/**
+ * @brief UniformBlock::getOffsetAlignment Get implementation dependent alignment of bound buffer ranges.
+ * @return Alignment in bytes.
+ */
+int UniformBlock::getOffsetAlignment()
+{
+    GLint alignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+
+    if(alignment <= 0)
+        alignment = 256;
+
+    return alignment;
+}
@@ -0,0 +1,70 @@
+#ifndef UNIFORMBLOCK_H
+#define UNIFORMBLOCK_H
+
+#define GLEW_STATIC
+#include <GL/glew.h>
+#include <QString>
+#include <QByteArray>
+#include <QHash>
+#include <QStringList>
+#include <QMatrix4x4>
+
+/**
+ * @brief The UniformBlock class Uniform buffer object with std140 layout. Values are written to client copy
+ * and uploaded to OpenGL buffer once by upload method. Shader programs use this buffer through uniform block
+ * bound to binding point of this object.
+ */
+class UniformBlock
+{
+public:
+    /**
+     * @brief The Member struct Layout of one member of uniform block read from linked shader program.
+     */
+    struct Member {
+        int offset;
+        int arrayStride;
+        int matrixStride;
+        int arraySize;
+    };
+
+    explicit UniformBlock(const QString blockName, GLuint bindingPoint);
+    ~UniformBlock();
+
+    bool create(int size);
+    void destroy();
+    bool isCreated() const;
+
+    bool attachProgram(GLuint programId) const;
+    bool readLayout(GLuint programId);
+    void clearLayout();
+    bool hasMember(const QString name) const;
+    Member getMember(const QString name) const;
+    QStringList getMemberNames() const;
+
+    QString getName() const;
+    GLuint getBindingPoint() const;
+    int getSize() const;
+
+    void setData(int offset, const void *data, int size);
+    void setFloats(int offset, const float *data, int count);
+    void setMatrix(int offset, const float *data, int columns, int rows, int matrixStride);
+    void setMatrix(int offset, const QMatrix4x4 &matrix);
+    void setMatrix(int offset, const QMatrix3x3 &matrix);
+
+    void upload();
+    void bindBase() const;
+    void bindRange(int offset, int size) const;
+
+    static int getOffsetAlignment();
+
+private:
+    QString name;
+    GLuint binding;
+    GLuint bufferId;
+    QByteArray data;
+    int dirtyBegin;
+    int dirtyEnd;
+    QHash<QString,Member> members;
+};
+
+#endif // UNIFORMBLOCK_H
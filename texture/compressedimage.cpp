@@ -0,0 +1,726 @@
+#include "compressedimage.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QtEndian>
+#include <QDataStream>
+#include <QObject>
+
+// OpenGL internal formats of block compressed textures (EXT_texture_compression_s3tc, EXT_texture_sRGB,
+// ARB_texture_compression_rgtc and ARB_texture_compression_bptc)
+#define COMPRESSED_RGB_S3TC_DXT1 0x83F0
+#define COMPRESSED_RGBA_S3TC_DXT1 0x83F1
+#define COMPRESSED_RGBA_S3TC_DXT3 0x83F2
+#define COMPRESSED_RGBA_S3TC_DXT5 0x83F3
+#define COMPRESSED_SRGB_S3TC_DXT1 0x8C4C
+#define COMPRESSED_SRGB_ALPHA_S3TC_DXT1 0x8C4D
+#define COMPRESSED_SRGB_ALPHA_S3TC_DXT3 0x8C4E
+#define COMPRESSED_SRGB_ALPHA_S3TC_DXT5 0x8C4F
+#define COMPRESSED_RED_RGTC1 0x8DBB
+#define COMPRESSED_SIGNED_RED_RGTC1 0x8DBC
+#define COMPRESSED_RG_RGTC2 0x8DBD
+#define COMPRESSED_SIGNED_RG_RGTC2 0x8DBE
+#define COMPRESSED_RGBA_BPTC_UNORM 0x8E8C
+#define COMPRESSED_SRGB_ALPHA_BPTC_UNORM 0x8E8D
+#define COMPRESSED_RGB_BPTC_SIGNED_FLOAT 0x8E8E
+#define COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT 0x8E8F
+
+// OpenGL base formats
+#define BASE_RED 0x1903
+#define BASE_RG 0x8227
+#define BASE_RGB 0x1907
+#define BASE_RGBA 0x1908
+
+// sizes of file headers
+#define DDS_HEADER_SIZE 128
+#define DDS_DX10_HEADER_SIZE 20
+#define KTX_HEADER_SIZE 64
+#define KTX2_HEADER_SIZE 80
+#define KTX2_LEVEL_INDEX_SIZE 24
+
+// DDS flags
+#define DDPF_FOURCC 0x4
+#define DDSCAPS2_CUBEMAP 0x200
+#define DDSCAPS2_VOLUME 0x200000
+
+static const char KTX_IDENTIFIER[12] = {'\xAB', 'K', 'T', 'X', ' ', '1', '1', '\xBB', '\r', '\n', '\x1A', '\n'};
+static const char KTX2_IDENTIFIER[12] = {'\xAB', 'K', 'T', 'X', ' ', '2', '0', '\xBB', '\r', '\n', '\x1A', '\n'};
+
+/**
+ * @brief makeFourCC Create DDS four character code.
+ * @param code Four characters of code.
+ * @return Four character code as little endian number.
+ */
+static quint32 makeFourCC(const char code[4])
+{
+    return qFromLittleEndian<quint32>(reinterpret_cast<const uchar*>(code));
+}
+
+/**
+ * @brief readUInt32 Read 32 bit unsigned number from file data, caller tests bounds.
+ * @param data File data.
+ * @param offset Offset of number in bytes.
+ * @param bigEndian True if number is stored as big endian.
+ * @return Read number.
+ */
+static quint32 readUInt32(const QByteArray &data, int offset, bool bigEndian = false)
+{
+    const uchar* src = reinterpret_cast<const uchar*>(data.constData() + offset);
+
+    return bigEndian ? qFromBigEndian<quint32>(src) : qFromLittleEndian<quint32>(src);
+}
+
+/**
+ * @brief readUInt64 Read 64 bit unsigned little endian number from file data, caller tests bounds.
+ * @param data File data.
+ * @param offset Offset of number in bytes.
+ * @return Read number.
+ */
+static quint64 readUInt64(const QByteArray &data, int offset)
+{
+    return qFromLittleEndian<quint64>(reinterpret_cast<const uchar*>(data.constData() + offset));
+}
+
+/**
+ * @brief CompressedImage::CompressedImage Create null image.
+ */
+CompressedImage::CompressedImage() :
+    internalFormat(0)
+{
+}
+
+/**
+ * @brief CompressedImage::load Load compressed image from file, container is recognized by its identifier.
+ * @param path Path to KTX, KTX2 or DDS file.
+ * @return True if image is loaded, false otherwise (reason is returned by getError).
+ */
+bool CompressedImage::load(const QString path)
+{
+    clear();
+
+    QFile f(path);
+
+    if(!f.open(QIODevice::ReadOnly))
+        return setError(QObject::tr("File %1 canno't be opened!").arg(path));
+
+    QByteArray file = f.readAll();
+    f.close();
+
+    bool loaded = false;
+
+    if(file.startsWith("DDS "))
+        loaded = loadDDS(file);
+    else if(file.startsWith(QByteArray(KTX_IDENTIFIER, sizeof(KTX_IDENTIFIER))))
+        loaded = loadKTX(file);
+    else if(file.startsWith(QByteArray(KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER))))
+        loaded = loadKTX2(file);
+    else
+        return setError(QObject::tr("Unknown container of compressed image!"));
+
+    if(loaded && levels.isEmpty())
+        return setError(QObject::tr("Compressed image has no mipmap level!"));
+
+    return loaded;
+}
+
+/**
+ * @brief CompressedImage::save Save image with all mipmap levels to KTX file.
+ * @param path Path to KTX file.
+ * @return True if file was written, false otherwise.
+ */
+bool CompressedImage::save(const QString path) const
+{
+    if(isNull())
+        return false;
+
+    QFile file(path);
+
+    if(!file.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream out(&file);
+    out.setByteOrder(QDataStream::LittleEndian);
+
+    out.writeRawData(KTX_IDENTIFIER, sizeof(KTX_IDENTIFIER));
+    out << static_cast<quint32>(0x04030201);    // endianness
+    out << static_cast<quint32>(0);             // glType, 0 for compressed
+    out << static_cast<quint32>(1);             // glTypeSize
+    out << static_cast<quint32>(0);             // glFormat, 0 for compressed
+    out << internalFormat;
+    out << getBaseFormat(internalFormat);
+    out << static_cast<quint32>(size.width());
+    out << static_cast<quint32>(size.height());
+    out << static_cast<quint32>(0);             // depth
+    out << static_cast<quint32>(0);             // array elements
+    out << static_cast<quint32>(1);             // faces
+    out << static_cast<quint32>(levels.size());
+    out << static_cast<quint32>(0);             // key value data
+
+    // block sizes are multiple of 4, so levels need no padding
+    foreach(const QByteArray& level, levels)
+    {
+        out << static_cast<quint32>(level.size());
+        out.writeRawData(level.constData(), level.size());
+    }
+
+    file.close();
+
+    return out.status() == QDataStream::Ok;
+}
+
+/**
+ * @brief CompressedImage::setData Set image from compressed mipmap levels.
+ * @param internalFormat OpenGL internal format of levels.
+ * @param size Size of base level.
+ * @param levels Compressed data of levels, base level first.
+ */
+void CompressedImage::setData(quint32 internalFormat, const QSize size, const QList<QByteArray> levels)
+{
+    clear();
+
+    this->internalFormat = internalFormat;
+    this->size = size;
+    this->levels = levels;
+}
+
+/**
+ * @brief CompressedImage::isNull Test if image has data.
+ * @return True if image is not loaded, false otherwise.
+ */
+bool CompressedImage::isNull() const
+{
+    return levels.isEmpty();
+}
+
+/**
+ * @brief CompressedImage::getError Get reason why last load failed.
+ * @return Error message, empty if image was loaded.
+ */
+QString CompressedImage::getError() const
+{
+    return error;
+}
+
+/**
+ * @brief CompressedImage::getInternalFormat Get OpenGL internal format of image.
+ * @return OpenGL internal format for glCompressedTexImage2D.
+ */
+quint32 CompressedImage::getInternalFormat() const
+{
+    return internalFormat;
+}
+
+/**
+ * @brief CompressedImage::getFormatName Get readable name of image format.
+ * @return Name of format.
+ */
+QString CompressedImage::getFormatName() const
+{
+    return getFormatName(internalFormat);
+}
+
+/**
+ * @brief CompressedImage::getSize Get size of base level.
+ * @return Size of image.
+ */
+QSize CompressedImage::getSize() const
+{
+    return size;
+}
+
+/**
+ * @brief CompressedImage::getLevelCount Get number of mipmap levels stored in file.
+ * @return Number of levels including base level.
+ */
+int CompressedImage::getLevelCount() const
+{
+    return levels.size();
+}
+
+/**
+ * @brief CompressedImage::getLevelSize Get size of mipmap level.
+ * @param level Mipmap level, 0 is base level.
+ * @return Size of level in pixels.
+ */
+QSize CompressedImage::getLevelSize(int level) const
+{
+    return QSize(qMax(size.width() >> level, 1), qMax(size.height() >> level, 1));
+}
+
+/**
+ * @brief CompressedImage::getLevel Get compressed data of mipmap level.
+ * @param level Mipmap level, 0 is base level.
+ * @return Compressed blocks of level.
+ */
+const QByteArray &CompressedImage::getLevel(int level) const
+{
+    return levels.at(level);
+}
+
+/**
+ * @brief CompressedImage::getMemorySize Get size of all mipmap levels in memory of graphics card.
+ * @return Size in bytes.
+ */
+qint64 CompressedImage::getMemorySize() const
+{
+    qint64 memory = 0;
+
+    foreach(const QByteArray& level, levels)
+        memory += level.size();
+
+    return memory;
+}
+
+/**
+ * @brief CompressedImage::isCompressedFile Test if file is compressed texture container by its suffix.
+ * @param path Path to file.
+ * @return True if file is KTX, KTX2 or DDS, false otherwise.
+ */
+bool CompressedImage::isCompressedFile(const QString path)
+{
+    QString suffix = QFileInfo(path).suffix().toLower();
+
+    return suffix == "ktx" || suffix == "ktx2" || suffix == "dds";
+}
+
+/**
+ * @brief CompressedImage::getFormatName Get readable name of OpenGL compressed format.
+ * @param internalFormat OpenGL internal format.
+ * @return Name of format, empty string for unknown format.
+ */
+QString CompressedImage::getFormatName(quint32 internalFormat)
+{
+    switch(internalFormat)
+    {
+    case COMPRESSED_RGB_S3TC_DXT1:
+        return "BC1 RGB (DXT1)";
+    case COMPRESSED_RGBA_S3TC_DXT1:
+        return "BC1 RGBA (DXT1)";
+    case COMPRESSED_SRGB_S3TC_DXT1:
+        return "BC1 sRGB (DXT1)";
+    case COMPRESSED_SRGB_ALPHA_S3TC_DXT1:
+        return "BC1 sRGBA (DXT1)";
+    case COMPRESSED_RGBA_S3TC_DXT3:
+        return "BC2 (DXT3)";
+    case COMPRESSED_SRGB_ALPHA_S3TC_DXT3:
+        return "BC2 sRGB (DXT3)";
+    case COMPRESSED_RGBA_S3TC_DXT5:
+        return "BC3 (DXT5)";
+    case COMPRESSED_SRGB_ALPHA_S3TC_DXT5:
+        return "BC3 sRGB (DXT5)";
+    case COMPRESSED_RED_RGTC1:
+        return "BC4 (RGTC1)";
+    case COMPRESSED_SIGNED_RED_RGTC1:
+        return "BC4 signed (RGTC1)";
+    case COMPRESSED_RG_RGTC2:
+        return "BC5 (RGTC2)";
+    case COMPRESSED_SIGNED_RG_RGTC2:
+        return "BC5 signed (RGTC2)";
+    case COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT:
+        return "BC6H unsigned float";
+    case COMPRESSED_RGB_BPTC_SIGNED_FLOAT:
+        return "BC6H signed float";
+    case COMPRESSED_RGBA_BPTC_UNORM:
+        return "BC7";
+    case COMPRESSED_SRGB_ALPHA_BPTC_UNORM:
+        return "BC7 sRGB";
+    }
+
+    return QString();
+}
+
+/**
+ * @brief CompressedImage::getBlockSize Get size of one 4x4 block of compressed format.
+ * @param internalFormat OpenGL internal format.
+ * @return Size of block in bytes, 0 for unknown format.
+ */
+int CompressedImage::getBlockSize(quint32 internalFormat)
+{
+    switch(internalFormat)
+    {
+    case COMPRESSED_RGB_S3TC_DXT1:
+    case COMPRESSED_RGBA_S3TC_DXT1:
+    case COMPRESSED_SRGB_S3TC_DXT1:
+    case COMPRESSED_SRGB_ALPHA_S3TC_DXT1:
+    case COMPRESSED_RED_RGTC1:
+    case COMPRESSED_SIGNED_RED_RGTC1:
+        return 8;
+    case COMPRESSED_RGBA_S3TC_DXT3:
+    case COMPRESSED_SRGB_ALPHA_S3TC_DXT3:
+    case COMPRESSED_RGBA_S3TC_DXT5:
+    case COMPRESSED_SRGB_ALPHA_S3TC_DXT5:
+    case COMPRESSED_RG_RGTC2:
+    case COMPRESSED_SIGNED_RG_RGTC2:
+    case COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT:
+    case COMPRESSED_RGB_BPTC_SIGNED_FLOAT:
+    case COMPRESSED_RGBA_BPTC_UNORM:
+    case COMPRESSED_SRGB_ALPHA_BPTC_UNORM:
+        return 16;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief CompressedImage::getLevelMemorySize Get size of compressed mipmap level.
+ * @param internalFormat OpenGL internal format.
+ * @param width Width of level.
+ * @param height Height of level.
+ * @return Size of level in bytes, 0 for unknown format.
+ */
+qint64 CompressedImage::getLevelMemorySize(quint32 internalFormat, int width, int height)
+{
+    qint64 blocksX = qMax((width + 3) / 4, 1);
+    qint64 blocksY = qMax((height + 3) / 4, 1);
+
+    return blocksX * blocksY * getBlockSize(internalFormat);
+}
+
+/**
+ * @brief CompressedImage::getBaseFormat Get OpenGL base format of compressed format, it is stored in KTX header.
+ * @param internalFormat OpenGL internal format.
+ * @return OpenGL base format.
+ */
+quint32 CompressedImage::getBaseFormat(quint32 internalFormat)
+{
+    switch(internalFormat)
+    {
+    case COMPRESSED_RED_RGTC1:
+    case COMPRESSED_SIGNED_RED_RGTC1:
+        return BASE_RED;
+    case COMPRESSED_RG_RGTC2:
+    case COMPRESSED_SIGNED_RG_RGTC2:
+        return BASE_RG;
+    case COMPRESSED_RGB_S3TC_DXT1:
+    case COMPRESSED_SRGB_S3TC_DXT1:
+    case COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT:
+    case COMPRESSED_RGB_BPTC_SIGNED_FLOAT:
+        return BASE_RGB;
+    }
+
+    return BASE_RGBA;
+}
+
+/**
+ * @brief CompressedImage::loadDDS Load DDS file with DXTn, ATIn or DX10 header.
+ * @param file Content of file.
+ * @return True if image is loaded, false otherwise.
+ */
+bool CompressedImage::loadDDS(const QByteArray &file)
+{
+    if(file.size() < DDS_HEADER_SIZE)
+        return setError(QObject::tr("DDS header is damaged!"));
+
+    int height = readUInt32(file, 12);
+    int width = readUInt32(file, 16);
+    quint32 levelCount = readUInt32(file, 28);
+    quint32 pixelFlags = readUInt32(file, 80);
+    quint32 fourCC = readUInt32(file, 84);
+    quint32 caps2 = readUInt32(file, 112);
+    int offset = DDS_HEADER_SIZE;
+
+    if(caps2 & (DDSCAPS2_CUBEMAP | DDSCAPS2_VOLUME))
+        return setError(QObject::tr("Cube map and volume DDS files are not supported!"));
+
+    if(!(pixelFlags & DDPF_FOURCC))
+        return setError(QObject::tr("Uncompressed DDS files are not supported!"));
+
+    if(fourCC == makeFourCC("DX10"))
+    {
+        if(file.size() < DDS_HEADER_SIZE + DDS_DX10_HEADER_SIZE)
+            return setError(QObject::tr("DDS header is damaged!"));
+
+        // texture arrays are not supported
+        if(readUInt32(file, DDS_HEADER_SIZE + 12) > 1)
+            return setError(QObject::tr("DDS texture arrays are not supported!"));
+
+        internalFormat = convertDXGIToGL(readUInt32(file, DDS_HEADER_SIZE));
+        offset += DDS_DX10_HEADER_SIZE;
+    }
+    else
+        internalFormat = convertFourCCToGL(fourCC);
+
+    if(internalFormat == 0)
+        return setError(QObject::tr("Format of DDS file is not block compressed!"));
+
+    int mipmaps;
+
+    if(!setSize(width, height, levelCount, mipmaps))
+        return false;
+
+    for(int level = 0; level < mipmaps; ++level)
+    {
+        QSize levelSize = getLevelSize(level);
+        qint64 length = getLevelMemorySize(internalFormat, levelSize.width(), levelSize.height());
+
+        if(!addLevel(file, offset, length))
+            return false;
+
+        offset += length;
+    }
+
+    return true;
+}
+
+/**
+ * @brief CompressedImage::loadKTX Load KTX file with compressed 2D texture.
+ * @param file Content of file.
+ * @return True if image is loaded, false otherwise.
+ */
+bool CompressedImage::loadKTX(const QByteArray &file)
+{
+    if(file.size() < KTX_HEADER_SIZE)
+        return setError(QObject::tr("KTX header is damaged!"));
+
+    // file written on big endian machine
+    bool swap = readUInt32(file, 12) != 0x04030201;
+
+    quint32 glType = readUInt32(file, 16, swap);
+    quint32 glInternalFormat = readUInt32(file, 28, swap);
+    int width = readUInt32(file, 36, swap);
+    int height = readUInt32(file, 40, swap);
+    quint32 depth = readUInt32(file, 44, swap);
+    quint32 arrayElements = readUInt32(file, 48, swap);
+    quint32 faces = readUInt32(file, 52, swap);
+    quint32 levelCount = readUInt32(file, 56, swap);
+    quint32 keyValueLength = readUInt32(file, 60, swap);
+
+    if(glType != 0 || getBlockSize(glInternalFormat) == 0)
+        return setError(QObject::tr("Format of KTX file is not block compressed!"));
+
+    if(depth > 0 || arrayElements > 0 || faces != 1)
+        return setError(QObject::tr("Only 2D textures are supported in KTX files!"));
+
+    internalFormat = glInternalFormat;
+
+    // 1D texture has zero height
+    int mipmaps;
+
+    if(!setSize(width, (height == 0) ? 1 : height, levelCount, mipmaps))
+        return false;
+
+    qint64 offset = KTX_HEADER_SIZE + static_cast<qint64>(keyValueLength);
+
+    for(int level = 0; level < mipmaps; ++level)
+    {
+        if(offset + 4 > file.size())
+            return setError(QObject::tr("KTX file is truncated!"));
+
+        quint32 length = readUInt32(file, offset, swap);
+        offset += 4;
+
+        if(!addLevel(file, offset, length))
+            return false;
+
+        // levels are aligned to 4 bytes
+        offset += (length + 3) & ~3u;
+    }
+
+    return true;
+}
+
+/**
+ * @brief CompressedImage::loadKTX2 Load KTX2 file with compressed 2D texture without supercompression.
+ * @param file Content of file.
+ * @return True if image is loaded, false otherwise.
+ */
+bool CompressedImage::loadKTX2(const QByteArray &file)
+{
+    if(file.size() < KTX2_HEADER_SIZE)
+        return setError(QObject::tr("KTX2 header is damaged!"));
+
+    quint32 vkFormat = readUInt32(file, 12);
+    int width = readUInt32(file, 20);
+    int height = readUInt32(file, 24);
+    quint32 depth = readUInt32(file, 28);
+    quint32 layers = readUInt32(file, 32);
+    quint32 faces = readUInt32(file, 36);
+    quint32 levelCount = readUInt32(file, 40);
+    quint32 supercompression = readUInt32(file, 44);
+
+    if(supercompression != 0)
+        return setError(QObject::tr("Supercompressed KTX2 files are not supported!"));
+
+    if(depth > 0 || layers > 0 || faces != 1)
+        return setError(QObject::tr("Only 2D textures are supported in KTX2 files!"));
+
+    internalFormat = convertVulkanToGL(vkFormat);
+
+    if(internalFormat == 0)
+        return setError(QObject::tr("Format of KTX2 file is not block compressed!"));
+
+    int mipmaps;
+
+    if(!setSize(width, (height == 0) ? 1 : height, levelCount, mipmaps))
+        return false;
+
+    if(file.size() < KTX2_HEADER_SIZE + mipmaps * KTX2_LEVEL_INDEX_SIZE)
+        return setError(QObject::tr("KTX2 header is damaged!"));
+
+    for(int level = 0; level < mipmaps; ++level)
+    {
+        int index = KTX2_HEADER_SIZE + level * KTX2_LEVEL_INDEX_SIZE;
+
+        if(!addLevel(file, readUInt64(file, index), readUInt64(file, index + 8)))
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief CompressedImage::setSize Set size of image from header and get number of levels which are read.
+ * Level count 0 means only base level in all supported containers, larger counts than full mipmap chain
+ * are clamped, so sizes of levels are always valid.
+ * @param width Width of base level.
+ * @param height Height of base level.
+ * @param levelCount Number of levels from header.
+ * @param mipmaps Returned number of levels to read.
+ * @return True if size is valid, false otherwise.
+ */
+bool CompressedImage::setSize(int width, int height, quint32 levelCount, int &mipmaps)
+{
+    if(width <= 0 || height <= 0)
+        return setError(QObject::tr("Size of compressed image is not valid!"));
+
+    size = QSize(width, height);
+
+    // floor(log2(max(width, height))) + 1
+    int maxLevels = 1;
+
+    for(int side = qMax(width, height); side > 1; side >>= 1)
+        ++maxLevels;
+
+    mipmaps = static_cast<int>(qMin(qMax(levelCount, 1u), static_cast<quint32>(maxLevels)));
+
+    return true;
+}
+
+/**
+ * @brief CompressedImage::addLevel Add next mipmap level from file, size of level is tested against its format.
+ * @param file Content of file.
+ * @param offset Offset of level data in file.
+ * @param length Length of level data.
+ * @return True if level was added, false if file is damaged.
+ */
+bool CompressedImage::addLevel(const QByteArray &file, qint64 offset, qint64 length)
+{
+    QSize levelSize = getLevelSize(levels.size());
+    qint64 expected = getLevelMemorySize(internalFormat, levelSize.width(), levelSize.height());
+
+    if(length < expected || offset < 0 || offset + expected > file.size())
+    {
+        clear();
+        return setError(QObject::tr("Compressed image is truncated!"));
+    }
+
+    levels.append(file.mid(offset, expected));
+
+    return true;
+}
+
+/**
+ * @brief CompressedImage::setError Remember reason why load failed.
+ * @param error Error message.
+ * @return Always false, so it can be returned from load methods.
+ */
+bool CompressedImage::setError(const QString error)
+{
+    this->error = error;
+    levels.clear();
+
+    return false;
+}
+
+/**
+ * @brief CompressedImage::clear Make this image null.
+ */
+void CompressedImage::clear()
+{
+    internalFormat = 0;
+    size = QSize();
+    levels.clear();
+    error.clear();
+}
+
+/**
+ * @brief CompressedImage::convertFourCCToGL Convert four character code of DDS file to OpenGL format.
+ * @param fourCC Four character code.
+ * @return OpenGL internal format, 0 if format is not supported.
+ */
+quint32 CompressedImage::convertFourCCToGL(quint32 fourCC)
+{
+    if(fourCC == makeFourCC("DXT1"))
+        return COMPRESSED_RGBA_S3TC_DXT1;
+    if(fourCC == makeFourCC("DXT3"))
+        return COMPRESSED_RGBA_S3TC_DXT3;
+    if(fourCC == makeFourCC("DXT5"))
+        return COMPRESSED_RGBA_S3TC_DXT5;
+    if(fourCC == makeFourCC("ATI1") || fourCC == makeFourCC("BC4U"))
+        return COMPRESSED_RED_RGTC1;
+    if(fourCC == makeFourCC("BC4S"))
+        return COMPRESSED_SIGNED_RED_RGTC1;
+    if(fourCC == makeFourCC("ATI2") || fourCC == makeFourCC("BC5U"))
+        return COMPRESSED_RG_RGTC2;
+    if(fourCC == makeFourCC("BC5S"))
+        return COMPRESSED_SIGNED_RG_RGTC2;
+
+    return 0;
+}
+
+/**
+ * @brief CompressedImage::convertDXGIToGL Convert DXGI format from DX10 header of DDS file to OpenGL format.
+ * @param dxgiFormat DXGI format.
+ * @return OpenGL internal format, 0 if format is not supported.
+ */
+quint32 CompressedImage::convertDXGIToGL(quint32 dxgiFormat)
+{
+    switch(dxgiFormat)
+    {
+    case 71: return COMPRESSED_RGBA_S3TC_DXT1;
+    case 72: return COMPRESSED_SRGB_ALPHA_S3TC_DXT1;
+    case 74: return COMPRESSED_RGBA_S3TC_DXT3;
+    case 75: return COMPRESSED_SRGB_ALPHA_S3TC_DXT3;
+    case 77: return COMPRESSED_RGBA_S3TC_DXT5;
+    case 78: return COMPRESSED_SRGB_ALPHA_S3TC_DXT5;
+    case 80: return COMPRESSED_RED_RGTC1;
+    case 81: return COMPRESSED_SIGNED_RED_RGTC1;
+    case 83: return COMPRESSED_RG_RGTC2;
+    case 84: return COMPRESSED_SIGNED_RG_RGTC2;
+    case 95: return COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT;
+    case 96: return COMPRESSED_RGB_BPTC_SIGNED_FLOAT;
+    case 98: return COMPRESSED_RGBA_BPTC_UNORM;
+    case 99: return COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief CompressedImage::convertVulkanToGL Convert Vulkan format from KTX2 header to OpenGL format.
+ * @param vkFormat Vulkan format.
+ * @return OpenGL internal format, 0 if format is not supported.
+ */
+quint32 CompressedImage::convertVulkanToGL(quint32 vkFormat)
+{
+    switch(vkFormat)
+    {
+    case 131: return COMPRESSED_RGB_S3TC_DXT1;
+    case 132: return COMPRESSED_SRGB_S3TC_DXT1;
+    case 133: return COMPRESSED_RGBA_S3TC_DXT1;
+    case 134: return COMPRESSED_SRGB_ALPHA_S3TC_DXT1;
+    case 135: return COMPRESSED_RGBA_S3TC_DXT3;
+    case 136: return COMPRESSED_SRGB_ALPHA_S3TC_DXT3;
+    case 137: return COMPRESSED_RGBA_S3TC_DXT5;
+    case 138: return COMPRESSED_SRGB_ALPHA_S3TC_DXT5;
+    case 139: return COMPRESSED_RED_RGTC1;
+    case 140: return COMPRESSED_SIGNED_RED_RGTC1;
+    case 141: return COMPRESSED_RG_RGTC2;
+    case 142: return COMPRESSED_SIGNED_RG_RGTC2;
+    case 143: return COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT;
+    case 144: return COMPRESSED_RGB_BPTC_SIGNED_FLOAT;
+    case 145: return COMPRESSED_RGBA_BPTC_UNORM;
+    case 146: return COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+    }
+
+    return 0;
+}
@@ -0,0 +1,59 @@
+#ifndef COMPRESSEDIMAGE_H
+#define COMPRESSEDIMAGE_H
+
+#include <QString>
+#include <QByteArray>
+#include <QList>
+#include <QSize>
+
+/**
+ * @brief The CompressedImage class Image with precompressed mipmap chain loaded from KTX, KTX2 or DDS file.
+ * Only block compressed formats BC1 - BC7 are loaded, data of levels are kept in format for
+ * glCompressedTexImage2D. Format is stored as OpenGL internal format.
+ */
+class CompressedImage
+{
+public:
+    CompressedImage();
+
+    bool load(const QString path);
+    bool save(const QString path) const;
+    void setData(quint32 internalFormat, const QSize size, const QList<QByteArray> levels);
+    bool isNull() const;
+    QString getError() const;
+
+    quint32 getInternalFormat() const;
+    QString getFormatName() const;
+    QSize getSize() const;
+    int getLevelCount() const;
+    QSize getLevelSize(int level) const;
+    const QByteArray& getLevel(int level) const;
+    qint64 getMemorySize() const;
+
+    static bool isCompressedFile(const QString path);
+    static QString getFormatName(quint32 internalFormat);
+    static int getBlockSize(quint32 internalFormat);
+    static qint64 getLevelMemorySize(quint32 internalFormat, int width, int height);
+    static quint32 getBaseFormat(quint32 internalFormat);
+
+private:
+    bool loadDDS(const QByteArray &file);
+    bool loadKTX(const QByteArray &file);
+    bool loadKTX2(const QByteArray &file);
+    bool setSize(int width, int height, quint32 levelCount, int &mipmaps);
+    bool addLevel(const QByteArray &file, qint64 offset, qint64 length);
+    bool setError(const QString error);
+    void clear();
+
+    static quint32 convertFourCCToGL(quint32 fourCC);
+    static quint32 convertDXGIToGL(quint32 dxgiFormat);
+    static quint32 convertVulkanToGL(quint32 vkFormat);
+
+private:
+    quint32 internalFormat;
+    QSize size;
+    QList<QByteArray> levels;
+    QString error;
+};
+
+#endif // COMPRESSEDIMAGE_H
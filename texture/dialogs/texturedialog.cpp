@@ -62,7 +62,7 @@ TextureDialog::~TextureDialog()
 void TextureDialog::addNewTexture()
 {
     QString fileName = QFileDialog::getOpenFileName(this,
-         tr("Open Image"), QDir::homePath(), tr("Image Files (*.png *.jpg *.bmp *.gif)"));
+         tr("Open Image"), QDir::homePath(), tr("Image Files (*.png *.jpg *.bmp *.gif);;Compressed Textures (*.ktx *.ktx2 *.dds)"));
 
     if(fileName == "")
         return;
@@ -1,7 +1,10 @@
 #include "texturesettingsdialog.h"
 #include "ui_texturesettingsdialog.h"
 #include "infomanager.h"
+#include "texture/compressedimage.h"
+#include "texture/textureencoder.h"
 #include <QMessageBox>
+#include <QImageReader>
 
 #define TEXNAME "Texture"
 
@@ -118,6 +121,9 @@ void TextureSettingsDialog::accept()
     texStorage->setType(target);
     texStorage->setMipmap(ui->mipmapChecker->isChecked());
 
+    int compression = ui->compressionBox->itemData(ui->compressionBox->currentIndex()).toInt();
+    texStorage->setCompression(static_cast<TextureStorage::TexCompression>(compression));
+
     int filter = ui->minFilterBox->itemData(ui->minFilterBox->currentIndex()).toInt();
     texStorage->setMinFilter(static_cast<TextureStorage::TexFilter>(filter));
     filter = ui->magFilterBox->itemData(ui->magFilterBox->currentIndex()).toInt();
@@ -192,6 +198,18 @@ void TextureSettingsDialog::setUpComponents()
     ui->clampRBox->setCurrentIndex(TextureStorage::REPEAT);
     ui->clampSBox->setCurrentIndex(TextureStorage::REPEAT);
     ui->clampTBox->setCurrentIndex(TextureStorage::REPEAT);
+
+    QStringList labelCompression = TextureStorage::getGLCompressionString();
+
+    for(int i = 0; i < labelCompression.size(); ++i)
+    {
+        ui->compressionBox->addItem(labelCompression.value(i), QVariant(i));
+    }
+
+    ui->compressionBox->setCurrentIndex(TextureStorage::NO_COMPRESSION);
+
+    connect(ui->compressionBox,SIGNAL(currentIndexChanged(int)),this,SLOT(compressionChanged(int)));
+    connect(ui->texTypeBox,SIGNAL(currentIndexChanged(int)),this,SLOT(typeChanged(int)));
 }
 
 /**
@@ -220,6 +238,10 @@ void TextureSettingsDialog::readTexture()
 
     ui->clampRBox->setCurrentIndex(texStorage->getRWrap());
     ui->clampSBox->setCurrentIndex(texStorage->getSWrap());
+
+    ui->compressionBox->setCurrentIndex(texStorage->getCompression());
+
+    typeChanged(ui->texTypeBox->currentIndex());
 }
 
 /**
@@ -288,6 +310,124 @@ void TextureSettingsDialog::setUpMinFilter()
 void TextureSettingsDialog::mipMapChecked(bool /*checked*/)
 {
     setUpMinFilter();
+    showFormat();
+}
+
+/**
+ * @brief TextureSettingsDialog::compressionChanged Show format and memory of texture with new compression.
+ * @param id Id of item set in compressionBox.
+ */
+void TextureSettingsDialog::compressionChanged(int /*id*/)
+{
+    showFormat();
+}
+
+/**
+ * @brief TextureSettingsDialog::typeChanged Enable compression only for 2D textures from uncompressed images,
+ * precompressed files are uploaded as they are.
+ * @param id Id of item set in texTypeBox.
+ */
+void TextureSettingsDialog::typeChanged(int id)
+{
+    bool is2D = ui->texTypeBox->itemData(id).toInt() == TextureStorage::TEXTURE_2D;
+
+    ui->compressionBox->setEnabled(is2D && !CompressedImage::isCompressedFile(ui->texPathLabel->text()));
+
+    showFormat();
+}
+
+/**
+ * @brief TextureSettingsDialog::showFormat Show format of texture and its size in memory of graphics card.
+ * Compressed images use their stored mipmap levels, other images are uploaded as RGBA8 or encoded to
+ * selected compression.
+ */
+void TextureSettingsDialog::showFormat()
+{
+    QString texPath = ui->texPathLabel->text();
+    qint64 memory = 0;
+
+    if(CompressedImage::isCompressedFile(texPath))
+    {
+        CompressedImage image;
+
+        if(!image.load(texPath))
+        {
+            ui->texFormatLabel->setText(image.getError());
+            ui->texMemoryLabel->setText("-");
+            return;
+        }
+
+        memory = image.getMemorySize();
+        ui->texFormatLabel->setText(tr("%1, %2x%3, %4 levels").arg(image.getFormatName())
+                                    .arg(image.getSize().width()).arg(image.getSize().height())
+                                    .arg(image.getLevelCount()));
+    }
+    else
+    {
+        QSize size = QImageReader(texPath).size();
+
+        if(!size.isValid())
+        {
+            ui->texFormatLabel->setText(tr("Unknown"));
+            ui->texMemoryLabel->setText("-");
+            return;
+        }
+
+        TextureStorage::TexType type = static_cast<TextureStorage::TexType>(
+                    ui->texTypeBox->itemData(ui->texTypeBox->currentIndex()).toInt());
+        int layers = TextureStorage::getLayerCount(type, size.width(), size.height());
+
+        if(layers == 0)
+        {
+            ui->texFormatLabel->setText(tr("Image is not column of square layers!"));
+            ui->texMemoryLabel->setText("-");
+            return;
+        }
+
+        // only 2D textures are encoded
+        TextureStorage::TexCompression compression = TextureStorage::NO_COMPRESSION;
+
+        if(type == TextureStorage::TEXTURE_2D)
+            compression = static_cast<TextureStorage::TexCompression>(
+                        ui->compressionBox->itemData(ui->compressionBox->currentIndex()).toInt());
+
+        quint32 internalFormat = TextureEncoder::getInternalFormat(compression);
+        QString formatName = (compression == TextureStorage::NO_COMPRESSION) ?
+                    QString("RGBA8") : CompressedImage::getFormatName(internalFormat);
+
+        int levels = 0;
+        int width = size.width();
+        int height = size.height() / layers;
+        int depth = layers;
+
+        // full mipmap chain when mipmaps are generated, only depth of 3D texture is reduced
+        forever
+        {
+            if(compression == TextureStorage::NO_COMPRESSION)
+                memory += static_cast<qint64>(width) * height * depth * 4;
+            else
+                memory += CompressedImage::getLevelMemorySize(internalFormat, width, height);
+
+            ++levels;
+
+            bool lastLevel = width == 1 && height == 1 && (depth == 1 || type != TextureStorage::TEXTURE_3D);
+
+            if(!ui->mipmapChecker->isChecked() || lastLevel)
+                break;
+
+            width = qMax(width / 2, 1);
+            height = qMax(height / 2, 1);
+
+            if(type == TextureStorage::TEXTURE_3D)
+                depth = qMax(depth / 2, 1);
+        }
+
+        ui->texFormatLabel->setText(tr("%1, %2x%3, %4 layers, %5 levels").arg(formatName)
+                                    .arg(size.width()).arg(size.height() / layers)
+                                    .arg(layers).arg(levels));
+    }
+
+    ui->texMemoryLabel->setText(tr("%1 KiB").arg(memory / 1024.0, 0, 'f', 1));
 }
 
 /**
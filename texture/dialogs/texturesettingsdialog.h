@@ -33,9 +33,12 @@ private:
     bool testNames();
 
     void setUpMinFilter();
+    void showFormat();
 
 private slots:
     void mipMapChecked(bool checked);
+    void compressionChanged(int id);
+    void typeChanged(int id);
     //void clampTvisibility(int id);
 
 private:
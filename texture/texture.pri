@@ -4,13 +4,17 @@ HEADERS += \
     texture/dialogs/texturedialog.h \
     texture/texturestorage.h \
     texture/dialogs/texturesettingsdialog.h \
-    texture/dialogs/texturedialogbutton.h
+    texture/dialogs/texturedialogbutton.h \
+    texture/compressedimage.h \
+    texture/textureencoder.h
 
 SOURCES += \
     texture/dialogs/texturedialog.cpp \
     texture/texturestorage.cpp \
     texture/dialogs/texturesettingsdialog.cpp \
-    texture/dialogs/texturedialogbutton.cpp
+    texture/dialogs/texturedialogbutton.cpp \
+    texture/compressedimage.cpp \
+    texture/textureencoder.cpp
 
 FORMS += \
     texture/dialogs/texturedialog.ui \
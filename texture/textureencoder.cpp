@@ -0,0 +1,621 @@
+#include "textureencoder.h"
+#include <QtConcurrentMap>
+#include <QCryptographicHash>
+#include <QVector>
+#include <QFile>
+#include <QDir>
+#include <cfloat>
+#include <cmath>
+#include <climits>
+
+// OpenGL internal formats of encoded textures
+#define COMPRESSED_RGB_S3TC_DXT1 0x83F0
+#define COMPRESSED_RGBA_S3TC_DXT5 0x83F3
+#define COMPRESSED_RED_RGTC1 0x8DBB
+#define COMPRESSED_RG_RGTC2 0x8DBD
+#define COMPRESSED_RGBA_BPTC_UNORM 0x8E8C
+
+// changed when encoder output changes, so old cached files are not used
+#define ENCODER_VERSION "1"
+
+// interpolation weights of BC7 with 4 bit indices
+static const int BC7_WEIGHTS[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+/**
+ * @brief findEndpoints Find endpoints of line which fits colors of block, line goes along principal axis of colors.
+ * @param block 16 RGBA texels.
+ * @param channels Number of used channels, 3 for RGB or 4 for RGBA.
+ * @param start First endpoint.
+ * @param end Second endpoint.
+ */
+static void findEndpoints(const uchar *block, int channels, float *start, float *end)
+{
+    float mean[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+    for(int i = 0; i < 16; ++i)
+        for(int c = 0; c < channels; ++c)
+            mean[c] += block[i * 4 + c];
+
+    for(int c = 0; c < channels; ++c)
+        mean[c] /= 16.0f;
+
+    float cov[4][4] = {{0.0f}};
+
+    for(int i = 0; i < 16; ++i)
+    {
+        float d[4];
+
+        for(int c = 0; c < channels; ++c)
+            d[c] = block[i * 4 + c] - mean[c];
+
+        for(int a = 0; a < channels; ++a)
+            for(int b = 0; b < channels; ++b)
+                cov[a][b] += d[a] * d[b];
+    }
+
+    // principal axis by power iteration, starts from extents of block
+    float axis[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+    for(int c = 0; c < channels; ++c)
+    {
+        int lo = 255, hi = 0;
+
+        for(int i = 0; i < 16; ++i)
+        {
+            lo = qMin(lo, static_cast<int>(block[i * 4 + c]));
+            hi = qMax(hi, static_cast<int>(block[i * 4 + c]));
+        }
+
+        axis[c] = hi - lo;
+    }
+
+    for(int iteration = 0; iteration < 8; ++iteration)
+    {
+        float next[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        float length = 0.0f;
+
+        for(int a = 0; a < channels; ++a)
+        {
+            for(int b = 0; b < channels; ++b)
+                next[a] += cov[a][b] * axis[b];
+
+            length += next[a] * next[a];
+        }
+
+        if(length < FLT_EPSILON)
+            break;
+
+        length = std::sqrt(length);
+
+        for(int c = 0; c < channels; ++c)
+            axis[c] = next[c] / length;
+    }
+
+    float length = 0.0f;
+
+    for(int c = 0; c < channels; ++c)
+        length += axis[c] * axis[c];
+
+    length = std::sqrt(length);
+
+    float minT = 0.0f, maxT = 0.0f;
+
+    if(length > FLT_EPSILON)
+    {
+        for(int c = 0; c < channels; ++c)
+            axis[c] /= length;
+
+        minT = FLT_MAX;
+        maxT = -FLT_MAX;
+
+        for(int i = 0; i < 16; ++i)
+        {
+            float t = 0.0f;
+
+            for(int c = 0; c < channels; ++c)
+                t += (block[i * 4 + c] - mean[c]) * axis[c];
+
+            minT = qMin(minT, t);
+            maxT = qMax(maxT, t);
+        }
+    }
+
+    for(int c = 0; c < channels; ++c)
+    {
+        start[c] = qBound(0.0f, mean[c] + axis[c] * minT, 255.0f);
+        end[c] = qBound(0.0f, mean[c] + axis[c] * maxT, 255.0f);
+    }
+}
+
+/**
+ * @brief packColor565 Quantize color to 16 bit RGB 5:6:5.
+ * @param color RGB color in range 0 - 255.
+ * @return Packed color.
+ */
+static quint16 packColor565(const float *color)
+{
+    int r = qRound(color[0] * 31.0f / 255.0f);
+    int g = qRound(color[1] * 63.0f / 255.0f);
+    int b = qRound(color[2] * 31.0f / 255.0f);
+
+    return static_cast<quint16>((r << 11) | (g << 5) | b);
+}
+
+/**
+ * @brief unpackColor565 Expand 16 bit RGB 5:6:5 color to 8 bits per channel like decoder does.
+ * @param packed Packed color.
+ * @param color Expanded RGB color.
+ */
+static void unpackColor565(quint16 packed, int *color)
+{
+    int r = (packed >> 11) & 31;
+    int g = (packed >> 5) & 63;
+    int b = packed & 31;
+
+    color[0] = (r << 3) | (r >> 2);
+    color[1] = (g << 2) | (g >> 4);
+    color[2] = (b << 3) | (b >> 2);
+}
+
+/**
+ * @brief writeBits Write bits to block, bits are stored from the least significant bit of first byte.
+ * @param out Block cleared to zero.
+ * @param position Position of first bit, it is moved behind written bits.
+ * @param value Written value.
+ * @param count Number of written bits.
+ */
+static void writeBits(uchar *out, int &position, int value, int count)
+{
+    for(int bit = 0; bit < count; ++bit, ++position)
+    {
+        if(value & (1 << bit))
+            out[position / 8] |= static_cast<uchar>(1 << (position % 8));
+    }
+}
+
+/**
+ * @brief TextureEncoder::encode Encode image with full mipmap chain when needed. Image is flipped to OpenGL
+ * orientation like uncompressed textures.
+ * @param image Source image.
+ * @param compression Format of compressed texture.
+ * @param mipmaps True if all mipmap levels are encoded, false for base level only.
+ * @return Compressed image, null image if compression is not set.
+ */
+CompressedImage TextureEncoder::encode(const QImage &image, TextureStorage::TexCompression compression, bool mipmaps)
+{
+    CompressedImage compressed;
+
+    if(image.isNull() || compression == TextureStorage::NO_COMPRESSION)
+        return compressed;
+
+    QImage level = image.convertToFormat(QImage::Format_RGBA8888).mirrored();
+    QList<QByteArray> levels;
+
+    forever
+    {
+        levels.append(encodeLevel(level, compression));
+
+        if(!mipmaps || (level.width() == 1 && level.height() == 1))
+            break;
+
+        level = level.scaled(qMax(level.width() / 2, 1), qMax(level.height() / 2, 1),
+                             Qt::IgnoreAspectRatio, Qt::SmoothTransformation)
+                .convertToFormat(QImage::Format_RGBA8888);
+    }
+
+    compressed.setData(getInternalFormat(compression), image.size(), levels);
+
+    return compressed;
+}
+
+/**
+ * @brief TextureEncoder::encodeCached Encode image file, encoded image is loaded from cache directory when
+ * the same file was encoded before. Key of cache is hash of file content and encoder settings.
+ * @param path Path to source image file.
+ * @param compression Format of compressed texture.
+ * @param mipmaps True if all mipmap levels are encoded, false for base level only.
+ * @param cacheDir Directory with encoded images, empty string disables cache.
+ * @return Compressed image, null image if file canno't be loaded.
+ */
+CompressedImage TextureEncoder::encodeCached(const QString path, TextureStorage::TexCompression compression,
+                                             bool mipmaps, const QString cacheDir)
+{
+    QFile file(path);
+
+    if(!file.open(QIODevice::ReadOnly))
+        return CompressedImage();
+
+    QByteArray source = file.readAll();
+    file.close();
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+
+    hash.addData(source);
+    hash.addData(QByteArray::number(compression));
+    hash.addData(mipmaps ? "mipmaps" : "base");
+    hash.addData(ENCODER_VERSION);
+
+    QString cachePath;
+    CompressedImage compressed;
+
+    if(!cacheDir.isEmpty())
+    {
+        cachePath = QDir(cacheDir).filePath(QString::fromLatin1(hash.result().toHex()) + ".ktx");
+
+        if(compressed.load(cachePath))
+            return compressed;
+    }
+
+    QImage image;
+
+    if(!image.loadFromData(source))
+        return CompressedImage();
+
+    compressed = encode(image, compression, mipmaps);
+
+    if(!cachePath.isEmpty() && QDir().mkpath(cacheDir))
+        compressed.save(cachePath);
+
+    return compressed;
+}
+
+/**
+ * @brief TextureEncoder::getInternalFormat Get OpenGL internal format of compression.
+ * @param compression Format of compressed texture.
+ * @return OpenGL internal format, 0 for NO_COMPRESSION.
+ */
+quint32 TextureEncoder::getInternalFormat(TextureStorage::TexCompression compression)
+{
+    switch(compression)
+    {
+    case TextureStorage::BC1:
+        return COMPRESSED_RGB_S3TC_DXT1;
+    case TextureStorage::BC3:
+        return COMPRESSED_RGBA_S3TC_DXT5;
+    case TextureStorage::BC4:
+        return COMPRESSED_RED_RGTC1;
+    case TextureStorage::BC5:
+        return COMPRESSED_RG_RGTC2;
+    case TextureStorage::BC7:
+        return COMPRESSED_RGBA_BPTC_UNORM;
+    case TextureStorage::NO_COMPRESSION:
+        break;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief TextureEncoder::encodeLevel Encode one mipmap level, rows of blocks are encoded in thread pool.
+ * @param image Level in RGBA8888 format.
+ * @param compression Format of compressed texture.
+ * @return Compressed blocks of level.
+ */
+QByteArray TextureEncoder::encodeLevel(const QImage &image, TextureStorage::TexCompression compression)
+{
+    int blocksX = (image.width() + 3) / 4;
+    int blocksY = (image.height() + 3) / 4;
+    int blockSize = CompressedImage::getBlockSize(getInternalFormat(compression));
+
+    QByteArray data(blocksX * blocksY * blockSize, 0);
+    QVector<BlockRow> rows(blocksY);
+
+    for(int y = 0; y < blocksY; ++y)
+    {
+        BlockRow& row = rows[y];
+
+        row.image = &image;
+        row.row = y;
+        row.compression = compression;
+        row.blockSize = blockSize;
+        row.output = data.data() + y * blocksX * blockSize;
+    }
+
+    QtConcurrent::blockingMap(rows, &TextureEncoder::encodeRow);
+
+    return data;
+}
+
+/**
+ * @brief TextureEncoder::encodeRow Encode one row of blocks. Called in worker thread.
+ * @param row Row of blocks and its place in output.
+ */
+void TextureEncoder::encodeRow(BlockRow &row)
+{
+    uchar block[64];
+    int blocksX = (row.image->width() + 3) / 4;
+
+    for(int x = 0; x < blocksX; ++x)
+    {
+        uchar* out = reinterpret_cast<uchar*>(row.output) + x * row.blockSize;
+
+        fetchBlock(*row.image, x * 4, row.row * 4, block);
+
+        switch(row.compression)
+        {
+        case TextureStorage::BC1:
+            encodeColorBlock(block, out);
+            break;
+        case TextureStorage::BC3:
+            encodeChannelBlock(block, 3, out);
+            encodeColorBlock(block, out + 8);
+            break;
+        case TextureStorage::BC4:
+            encodeChannelBlock(block, 0, out);
+            break;
+        case TextureStorage::BC5:
+            encodeChannelBlock(block, 0, out);
+            encodeChannelBlock(block, 1, out + 8);
+            break;
+        case TextureStorage::BC7:
+            encodeBC7Block(block, out);
+            break;
+        case TextureStorage::NO_COMPRESSION:
+            break;
+        }
+    }
+}
+
+/**
+ * @brief TextureEncoder::fetchBlock Copy 4x4 texels from image, texels outside of image repeat its edge.
+ * @param image Image in RGBA8888 format.
+ * @param x Left column of block.
+ * @param y Top row of block.
+ * @param block 16 RGBA texels.
+ */
+void TextureEncoder::fetchBlock(const QImage &image, int x, int y, uchar *block)
+{
+    for(int by = 0; by < 4; ++by)
+    {
+        const uchar* line = image.constScanLine(qMin(y + by, image.height() - 1));
+
+        for(int bx = 0; bx < 4; ++bx)
+        {
+            const uchar* texel = line + qMin(x + bx, image.width() - 1) * 4;
+            uchar* dst = block + (by * 4 + bx) * 4;
+
+            dst[0] = texel[0];
+            dst[1] = texel[1];
+            dst[2] = texel[2];
+            dst[3] = texel[3];
+        }
+    }
+}
+
+/**
+ * @brief TextureEncoder::encodeColorBlock Encode RGB of block to BC1 block in four color mode.
+ * @param block 16 RGBA texels.
+ * @param out 8 bytes of BC1 block.
+ */
+void TextureEncoder::encodeColorBlock(const uchar *block, uchar *out)
+{
+    float start[4], end[4];
+    findEndpoints(block, 3, start, end);
+
+    quint16 color0 = packColor565(end);
+    quint16 color1 = packColor565(start);
+
+    // four color mode needs color0 > color1
+    if(color0 < color1)
+        qSwap(color0, color1);
+
+    quint32 indices = 0;
+
+    if(color0 != color1)
+    {
+        int palette[4][3];
+
+        unpackColor565(color0, palette[0]);
+        unpackColor565(color1, palette[1]);
+
+        for(int c = 0; c < 3; ++c)
+        {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+
+        for(int i = 0; i < 16; ++i)
+        {
+            int best = 0;
+            int bestError = INT_MAX;
+
+            for(int k = 0; k < 4; ++k)
+            {
+                int error = 0;
+
+                for(int c = 0; c < 3; ++c)
+                {
+                    int d = block[i * 4 + c] - palette[k][c];
+                    error += d * d;
+                }
+
+                if(error < bestError)
+                {
+                    best = k;
+                    bestError = error;
+                }
+            }
+
+            indices |= static_cast<quint32>(best) << (2 * i);
+        }
+    }
+
+    out[0] = color0 & 0xFF;
+    out[1] = color0 >> 8;
+    out[2] = color1 & 0xFF;
+    out[3] = color1 >> 8;
+
+    for(int k = 0; k < 4; ++k)
+        out[4 + k] = (indices >> (8 * k)) & 0xFF;
+}
+
+/**
+ * @brief TextureEncoder::encodeChannelBlock Encode one channel of block to BC4 block in eight value mode,
+ * the same block is used for alpha of BC3 and both channels of BC5.
+ * @param block 16 RGBA texels.
+ * @param channel Encoded channel.
+ * @param out 8 bytes of BC4 block.
+ */
+void TextureEncoder::encodeChannelBlock(const uchar *block, int channel, uchar *out)
+{
+    int hi = 0, lo = 255;
+
+    for(int i = 0; i < 16; ++i)
+    {
+        hi = qMax(hi, static_cast<int>(block[i * 4 + channel]));
+        lo = qMin(lo, static_cast<int>(block[i * 4 + channel]));
+    }
+
+    quint64 indices = 0;
+
+    if(hi > lo)
+    {
+        int palette[8];
+
+        palette[0] = hi;
+        palette[1] = lo;
+
+        for(int k = 1; k < 7; ++k)
+            palette[k + 1] = ((7 - k) * hi + k * lo + 3) / 7;
+
+        for(int i = 0; i < 16; ++i)
+        {
+            int value = block[i * 4 + channel];
+            int best = 0;
+            int bestError = INT_MAX;
+
+            for(int k = 0; k < 8; ++k)
+            {
+                int error = qAbs(value - palette[k]);
+
+                if(error < bestError)
+                {
+                    best = k;
+                    bestError = error;
+                }
+            }
+
+            indices |= static_cast<quint64>(best) << (3 * i);
+        }
+    }
+
+    out[0] = static_cast<uchar>(hi);
+    out[1] = static_cast<uchar>(lo);
+
+    for(int k = 0; k < 6; ++k)
+        out[2 + k] = (indices >> (8 * k)) & 0xFF;
+}
+
+/**
+ * @brief TextureEncoder::encodeBC7Block Encode block to BC7 mode 6 block (one subset, RGBA endpoints with
+ * 7 bits and p-bit, 4 bit indices).
+ * @param block 16 RGBA texels.
+ * @param out 16 bytes of BC7 block.
+ */
+void TextureEncoder::encodeBC7Block(const uchar *block, uchar *out)
+{
+    float endpoints[2][4];
+    findEndpoints(block, 4, endpoints[0], endpoints[1]);
+
+    int quantized[2][4];
+    int pbits[2];
+    int colors[2][4];
+
+    // p-bit is shared by all channels of endpoint, use the one with smaller error
+    for(int e = 0; e < 2; ++e)
+    {
+        float bestError = FLT_MAX;
+
+        for(int p = 0; p < 2; ++p)
+        {
+            int q[4];
+            float error = 0.0f;
+
+            for(int c = 0; c < 4; ++c)
+            {
+                q[c] = qBound(0, qRound((endpoints[e][c] - p) / 2.0f), 127);
+
+                float d = (q[c] * 2 + p) - endpoints[e][c];
+                error += d * d;
+            }
+
+            if(error < bestError)
+            {
+                bestError = error;
+                pbits[e] = p;
+
+                for(int c = 0; c < 4; ++c)
+                    quantized[e][c] = q[c];
+            }
+        }
+
+        for(int c = 0; c < 4; ++c)
+            colors[e][c] = quantized[e][c] * 2 + pbits[e];
+    }
+
+    int palette[16][4];
+
+    for(int k = 0; k < 16; ++k)
+        for(int c = 0; c < 4; ++c)
+            palette[k][c] = ((64 - BC7_WEIGHTS[k]) * colors[0][c] + BC7_WEIGHTS[k] * colors[1][c] + 32) >> 6;
+
+    int indices[16];
+
+    for(int i = 0; i < 16; ++i)
+    {
+        int best = 0;
+        int bestError = INT_MAX;
+
+        for(int k = 0; k < 16; ++k)
+        {
+            int error = 0;
+
+            for(int c = 0; c < 4; ++c)
+            {
+                int d = block[i * 4 + c] - palette[k][c];
+                error += d * d;
+            }
+
+            if(error < bestError)
+            {
+                best = k;
+                bestError = error;
+            }
+        }
+
+        indices[i] = best;
+    }
+
+    // most significant bit of the first index is not stored, it must be zero
+    if(indices[0] & 8)
+    {
+        for(int c = 0; c < 4; ++c)
+            qSwap(quantized[0][c], quantized[1][c]);
+
+        qSwap(pbits[0], pbits[1]);
+
+        for(int i = 0; i < 16; ++i)
+            indices[i] = 15 - indices[i];
+    }
+
+    for(int k = 0; k < 16; ++k)
+        out[k] = 0;
+
+    int position = 0;
+
+    writeBits(out, position, 1 << 6, 7);    // mode 6
+
+    for(int c = 0; c < 4; ++c)
+    {
+        writeBits(out, position, quantized[0][c], 7);
+        writeBits(out, position, quantized[1][c], 7);
+    }
+
+    writeBits(out, position, pbits[0], 1);
+    writeBits(out, position, pbits[1], 1);
+
+    writeBits(out, position, indices[0], 3);
+
+    for(int i = 1; i < 16; ++i)
+        writeBits(out, position, indices[i], 4);
+}
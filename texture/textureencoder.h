@@ -0,0 +1,42 @@
+#ifndef TEXTUREENCODER_H
+#define TEXTUREENCODER_H
+
+#include "texture/texturestorage.h"
+#include "texture/compressedimage.h"
+#include <QImage>
+
+/**
+ * @brief The TextureEncoder class Block compression of images to BC1, BC3, BC4, BC5 and BC7 formats. Rows of blocks
+ * are encoded in thread pool, encoded images are cached in KTX files under hash of source file.
+ */
+class TextureEncoder
+{
+public:
+    static CompressedImage encode(const QImage &image, TextureStorage::TexCompression compression, bool mipmaps);
+    static CompressedImage encodeCached(const QString path, TextureStorage::TexCompression compression,
+                                        bool mipmaps, const QString cacheDir);
+
+    static quint32 getInternalFormat(TextureStorage::TexCompression compression);
+
+private:
+    /**
+     * @brief The BlockRow struct One row of 4x4 blocks encoded by one task of thread pool.
+     */
+    struct BlockRow {
+        const QImage* image;
+        int row;
+        TextureStorage::TexCompression compression;
+        int blockSize;
+        char* output;
+    };
+
+    static QByteArray encodeLevel(const QImage &image, TextureStorage::TexCompression compression);
+    static void encodeRow(BlockRow &row);
+    static void fetchBlock(const QImage &image, int x, int y, uchar *block);
+
+    static void encodeColorBlock(const uchar *block, uchar *out);
+    static void encodeChannelBlock(const uchar *block, int channel, uchar *out);
+    static void encodeBC7Block(const uchar *block, uchar *out);
+};
+
+#endif // TEXTUREENCODER_H
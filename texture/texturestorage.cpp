@@ -6,7 +6,8 @@
  * @param parent Parent of this object.
  */
 TextureStorage::TextureStorage(QObject *parent) :
-    QObject(parent)
+    QObject(parent),
+    compression(NO_COMPRESSION)
 {
 }
 
@@ -147,9 +148,9 @@ bool TextureStorage::convertPathToAbsolute(QString path)
 QStringList TextureStorage::getGLTypeString()
 {
     QStringList ret;
-    ret << "TEXTURE_1D" << "TEXTURE_2D";
-           /* << "TEXTURE_3D" << "TEXTURE_1D_ARRAY" << "TEXTURE_2D_ARRAY"
-        << "TEXTURE_RECTANGLE" << "TEXTURE_CUBE_MAP" << "TEXTURE_CUBE_MAP_ARRAY" << "TEXTURE_BUFFER"
+    ret << "TEXTURE_1D" << "TEXTURE_2D" << "TEXTURE_3D" << "TEXTURE_2D_ARRAY" << "TEXTURE_CUBE_MAP";
+           /* << "TEXTURE_1D_ARRAY"
+        << "TEXTURE_RECTANGLE" << "TEXTURE_CUBE_MAP_ARRAY" << "TEXTURE_BUFFER"
         << "TEXTURE_2D_MULTISAMPLE" << "TEXTURE_2D_MULTISAMPLE_ARRAY";
             */
     return ret;
@@ -180,9 +181,49 @@ QStringList TextureStorage::getGLWrapString()
     return ret;
 }
 
+/**
+ * @brief TextureStorage::getGLCompressionString Get list of strings with TexCompression enum as strings in the same order.
+ * @return Return TexCompression as strings.
+ */
+QStringList TextureStorage::getGLCompressionString()
+{
+    QStringList ret;
+    ret << "NONE" << "BC1" << "BC3" << "BC4" << "BC5" << "BC7";
+
+    return ret;
+}
+
+/**
+ * @brief TextureStorage::getLayerCount Get number of layers or faces stored in image as square tiles.
+ * @param type Texture type.
+ * @param width Width of image.
+ * @param height Height of image.
+ * @return Number of layers (1 for 1D and 2D texture, 6 for cube map), 0 if image canno't be split to tiles.
+ */
+int TextureStorage::getLayerCount(TextureStorage::TexType type, int width, int height)
+{
+    switch(type)
+    {
+    case TEXTURE_1D:
+    case TEXTURE_2D:
+        return 1;
+    case TEXTURE_3D:
+    case TEXTURE_2D_ARRAY:
+        if(width > 0 && height % width == 0)
+            return height / width;
+        break;
+    case TEXTURE_CUBE_MAP:
+        if(height == 6 * width && width > 0)
+            return 6;
+        break;
+    }
+
+    return 0;
+}
+
 /**
  * @brief TextureStorage::setType Set texture type for this texture.
- * @param type Texture type (TEXTURE_1D, TEXTURE_2D).
+ * @param type Texture type (TEXTURE_1D, TEXTURE_2D, TEXTURE_3D, TEXTURE_2D_ARRAY, TEXTURE_CUBE_MAP).
  */
 void TextureStorage::setType(TextureStorage::TexType type)
 {
@@ -246,6 +287,15 @@ void TextureStorage::setMipmapLevel(unsigned int level)
     mipmapLevel = level;
 }
 
+/**
+ * @brief TextureStorage::setCompression Set block compression used when image is imported.
+ * @param compression Format of compressed texture, NO_COMPRESSION for RGBA texture.
+ */
+void TextureStorage::setCompression(TextureStorage::TexCompression compression)
+{
+    this->compression = compression;
+}
+
 /**
  * @brief TextureStorage::getType Get OpenGL type of this texture.
  * @return Return texture type.
@@ -309,6 +359,15 @@ unsigned int TextureStorage::getMipMapLevel() const
     return mipmapLevel;
 }
 
+/**
+ * @brief TextureStorage::getCompression Get block compression used when image is imported.
+ * @return Return format of compressed texture.
+ */
+TextureStorage::TexCompression TextureStorage::getCompression() const
+{
+    return compression;
+}
+
 /**
  * @brief TextureStorage::copy Create and return copy of this object.
  * @return Return copy of this object.
@@ -322,6 +381,7 @@ const TextureStorage *TextureStorage::copy()
     tex->magFilter = this->magFilter;
     tex->rWrap = this->rWrap;
     tex->sWrap = this->sWrap;
+    tex->compression = this->compression;
 
     return tex;
 }
@@ -363,6 +423,8 @@ void TextureStorage::setupObject()
 
     generateMipMap = false;
     mipmapLevel = 0;
+
+    compression = NO_COMPRESSION;
 }
 
 /**
@@ -10,10 +10,14 @@ class TextureStorage : public QObject
     Q_OBJECT
 
 public:
-    enum TexType {TEXTURE_1D = 0, TEXTURE_2D};
+    /**
+     * Layers of TEXTURE_3D and TEXTURE_2D_ARRAY and faces of TEXTURE_CUBE_MAP are square tiles stacked
+     * from top to bottom of one image, faces are in order +X, -X, +Y, -Y, +Z, -Z.
+     */
+    enum TexType {TEXTURE_1D = 0, TEXTURE_2D, TEXTURE_3D, TEXTURE_2D_ARRAY, TEXTURE_CUBE_MAP};
 
-    /*           TEXTURE_3D, TEXTURE_1D_ARRAY, TEXTURE_2D_ARRAY,
-                 TEXTURE_RECTANGLE, TEXTURE_CUBE_MAP, TEXTURE_CUBE_MAP_ARRAY, TEXTURE_BUFFER,
+    /*           TEXTURE_1D_ARRAY,
+                 TEXTURE_RECTANGLE, TEXTURE_CUBE_MAP_ARRAY, TEXTURE_BUFFER,
                  TEXTURE_2D_MULTISAMPLE, TEXTURE_2D_MULTISAMPLE_ARRAY};
     */
 
@@ -22,6 +26,8 @@ public:
 
     enum TexWrap {CLAMP_TO_EDGE = 0, CLAMP_TO_BORDER, MIRRORED_REPEAT, REPEAT};
 
+    enum TexCompression {NO_COMPRESSION = 0, BC1, BC3, BC4, BC5, BC7};
+
     TextureStorage(QObject* parent = NULL);
     TextureStorage(QString name, QString path, TexType type, QObject* parent = NULL);
     //TextureStorage(QString name, QString path, TexType type, QImage tex);
@@ -47,6 +53,8 @@ public:
     static QStringList getGLTypeString();
     static QStringList getGLFilterString();
     static QStringList getGLWrapString();
+    static QStringList getGLCompressionString();
+    static int getLayerCount(TexType type, int width, int height);
 
 
     void setType(TexType type);
@@ -56,6 +64,7 @@ public:
     void setRWrap(TexWrap wrap);
     void setMipmap(bool generate);
     void setMipmapLevel(unsigned int level);
+    void setCompression(TexCompression compression);
 
 
     TexType getType() const;
@@ -65,6 +74,7 @@ public:
     TexWrap getRWrap() const;
     bool isMipMap() const;
     unsigned int getMipMapLevel() const;
+    TexCompression getCompression() const;
 
     const TextureStorage* copy();
     bool exists() const;
@@ -96,6 +106,7 @@ private:
     TexWrap rWrap;
     bool generateMipMap;
     unsigned int mipmapLevel;
+    TexCompression compression;
     QString basePath;
 };
 
@@ -3,11 +3,14 @@
 
 using namespace UniformTypes;
 
+quint64 UniformVariable::versionCounter = 0;
+
 /**
  * @brief UniformVariable::UniformVariable Create empty object for store information about uniform variable.
  */
 UniformVariable::UniformVariable()
 {
+    updateVersion();
 }
 
 /**
@@ -63,6 +66,8 @@ void UniformVariable::loadVariableData(QString name,
     this->uniformType = uniformType;
     this->isMultiply = multiplyMode;
 
+    updateVersion();
+
     switch(uniformSize)
     {
     case SCALAR:
@@ -383,6 +388,7 @@ bool UniformVariable::isArray() const
 void UniformVariable::setMultiplyMode(bool multiply)
 {
     isMultiply = multiply;
+    updateVersion();
 }
 
 /**
@@ -394,6 +400,24 @@ bool UniformVariable::isMultiplyMode() const
     return isMultiply;
 }
 
+/**
+ * @brief UniformVariable::getVersion Get version of values of this uniform variable. Version is changed every time
+ * values can change, versions are unique for all uniform variables.
+ * @return Version of values.
+ */
+quint64 UniformVariable::getVersion() const
+{
+    return version;
+}
+
+/**
+ * @brief UniformVariable::updateVersion Set new unique version, values of this uniform variable changed.
+ */
+void UniformVariable::updateVersion()
+{
+    version = ++versionCounter;
+}
+
 /**
  * @brief UniformVariable::isAttached Return true if this uniform variable is attached somewhere
  * @return True if is attached or False
@@ -904,6 +928,8 @@ void UniformVariable::incrementTimeTimers(long time)
 
         it.next();
     }
+
+    updateVersion();
 }
 
 /**
@@ -985,6 +1011,8 @@ void UniformVariable::incrementActionPressedTimers(long time, bool* buttonPresse
 
         it.next();
     }
+
+    updateVersion();
 }
 
 /**
@@ -1027,6 +1055,8 @@ void UniformVariable::toggleAction(int buttonId)
             cellsFloat.value(p.first)->calculate();
         }
     }
+
+    updateVersion();
 }
 
 /**
@@ -1082,6 +1112,8 @@ void UniformVariable::resetToDefaults()
 
         it.next();
     }
+
+    updateVersion();
 }
 
 
@@ -1371,6 +1403,7 @@ void UniformVariable::loadUniform(QDataStream &stream, UniformVariable &variable
 
     variable.createCells();
     variable.findTimers();
+    variable.updateVersion();
 }
 
 
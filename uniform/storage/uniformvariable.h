@@ -72,6 +72,8 @@ public:
     void setMultiplyMode(bool multiply);
     bool isMultiplyMode() const;
 
+    quint64 getVersion() const;
+
     //attachments to variables
     bool isAttached() const;
     void addAttachment(QString programName, QString variableName);
@@ -121,6 +123,7 @@ public:
 
 private:
     void removeOldSettings();
+    void updateVersion();
     void createCells();
     void findTimers();
     static void saveUniform(QDataStream& stream, const UniformVariable& variable);
@@ -219,6 +222,9 @@ private:
 
     bool isMultiply;
 
+    quint64 version;
+    static quint64 versionCounter;
+
     QList<UniformTypes::Attachment> attach;
     QList<UniformCell<int>*> cellsInt;
     QList<UniformCell<uint>*> cellsUInt;